@@ -1,7 +1,6 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
 
 extern "C" {
 #include "driverlib/fpu.h"
@@ -15,8 +14,14 @@ extern "C" {
 }
 
 #include "button.h"
+#include "buttonEvents.h"
 #include "timerLib.h"
-#include "elapsedTime.h"
+#include "scheduler.h"
+#include "ticklessIdle.h"
+#include "stopwatch.h"
+#include "laps.h"
+#include "widgets.h"
+#include "fixedFormat.h"
 
 //#include "buttonDriver.h"
 //#include "timerLib.h"
@@ -28,33 +33,55 @@ static constexpr uint32_t BUTTON_TICK_MS     = 20U;
 static constexpr uint32_t DISPLAY_REFRESH_MS = 16U;
 
 uint32_t gSystemClock = 0;
-volatile uint32_t gStopwatchMs = 0;
-volatile bool gRunning = false;
 
-//Time
-uint32_t currentMs;
-uint32_t currentSec;
-uint32_t currentMin;
-uint32_t currentHr;
+// Time base and stopwatch: elapsed time is kept as timer ticks taken at the
+// start/stop edges, so a slow loop pass does not drift it
+static Timer timer;
+static Stopwatch stopwatch(timer);
+
+// Periodic work runs from the scheduler, highest priority first when
+// several tasks are due on the same pass
+static Scheduler scheduler(timer);
+
+// Between tasks the CPU sleeps until the next deadline (TIMER1 one-shot) or
+// any interrupt; idle.stats() and idle.dutyCyclePermille() show how long
+// it slept and how late it woke
+static TicklessIdle idle(timer);
+static tContext sContext;
+
+// Laps: S2 pushes the split while running, the loop turns it into a lap
+static LapRecorder<16> laps;
 
 // ============================================================================
-// STRUCT: Simple GUI Button (for drawing)
+// Screen widgets (repainted only when their value changes)
 // ============================================================================
-struct MyButton {
-    int x, y, w, h;
-    const char* label;
-    bool pressed;
-};
+static Label        lblTitle(0, 2, 128, 8, "STOPWATCH", ClrCyan);
+static StatusText   lblStatus(0, 13, 128, 8, "Running", ClrCyan, "Stopped", ClrCyan);
+static NumericField fldTime(28, 25, 12, 6, 8, ClrOlive);   // hh:mm:ss:mmm
+static TextList     lstLaps(25, 37, 78, 3, 8, ClrWhite);    // newest lap on top
+static TextList     lstStats(25, 63, 78, 4, 8, ClrCyan);    // min / max / avg / sd
+static ButtonWidget btnStart(15, 100, 50, 26, "PLAY");
+static ButtonWidget btnClear(70, 100, 50, 26, "RESET");
+
+// Time text, rewritten digit by digit as the fields change
+static FixedFormat<':', 2, 2, 2, 3> timeFormat;
+static char timeText[timeFormat.LENGTH + 1];
 
-// One on-screen button: Play / Pause
-static MyButton btnStart = {15, 80, 50, 28, "PLAY", false};
-static MyButton btnClear = {70, 80, 50, 28, "RESET", false};
+// Lap times, "mm:ss:mmm"
+using LapTimeFormat = FixedFormat<':', 2, 2, 3>;
+
+static Widget *const screenWidgets[] = {&lblTitle, &lblStatus, &fldTime, &lstLaps, &lstStats, &btnStart, &btnClear};
+static constexpr uint32_t SCREEN_WIDGET_COUNT = sizeof(screenWidgets) / sizeof(screenWidgets[0]);
 
 // ============================================================================
 // Hardware button
 // ============================================================================
-static Button btnPlayPause(S1);  // S1 → Play/Pause
-static Button btnReset(S2); //S2 -> Reset
+static SimpleButton btnPlayPause(S1);  // S1 → Play/Pause
+static SimpleButton btnReset(S2); //S2 -> Lap while running, Reset while stopped
+
+// Button ids in the input event queue
+enum : uint8_t { BTN_PLAY_PAUSE, BTN_RESET };
+static ButtonEventQueue<16> inputEvents;
 
 // ============================================================================
 // Function prototypes
@@ -62,8 +89,11 @@ static Button btnReset(S2); //S2 -> Reset
 static void initializeDisplay(tContext &context);
 static void configureTimer(Timer &timer);
 static void setupButtons();
-static void drawStopwatchScreen(tContext &context, uint32_t currentHr, uint32_t currentMin, uint32_t currentS, uint32_t currentMs, bool running);
-static void drawButton(tContext &context, const MyButton &btn);
+static void setupTasks();
+static void pollButtonsTask();
+static void refreshScreenTask();
+static void updateStopwatchScreen();
+static void showLap(const LapRecorder<16>::Lap &lap);
 
 static void onPlayPauseClick();
 static void onPlayPauseRelease();
@@ -80,103 +110,74 @@ int main(void)
 
     gSystemClock = SysCtlClockFreqSet(SYSCTL_XTAL_25MHZ | SYSCTL_OSC_MAIN |SYSCTL_USE_PLL | SYSCTL_CFG_VCO_480,120000000);
 
-    tContext sContext;
     initializeDisplay(sContext);
 
-    Timer timer;
     configureTimer(timer);
 
-    elapsedMillis buttonTick(timer);
-    elapsedMillis displayTick(timer);
-    elapsedMillis stopwatchTick(timer);
-
     setupButtons();
+    setupTasks();
     IntMasterEnable();
 
-    uint32_t lastDisplayedSec = static_cast<uint32_t>(-1);
-    bool lastRunning = !gRunning;
-
     while (true) {
-        // --- Poll physical button ---
-        if (buttonTick >= BUTTON_TICK_MS) {
-            btnPlayPause.tick();
-            btnReset.tick();
-            buttonTick = 0;
-        }
-
-        // --- Handle Play/Pause button ---
-        if (btnPlayPause.wasPressed()) {
-            btnStart.pressed = true;
-            onPlayPauseClick();
-        }
-        if (btnPlayPause.wasReleased()) {
-            btnStart.pressed = false;
-            onPlayPauseRelease();
-        }
-        //--- Handle Reset button ---
-        if (btnReset.wasPressed()){
-            btnClear.pressed = true;
-            onResetClick();
-        }
-        if(btnReset.wasReleased()){
-            btnClear.pressed = false;
+        if (!scheduler.run()) {
+            idle.sleepUntil(scheduler.nextDeadline());
         }
+    }
+}
 
-        // --- Stopwatch logic ---
-        if (gRunning) {
-            uint32_t delta = stopwatchTick;
-            if (delta > 0U) {
-                gStopwatchMs += delta;
-                stopwatchTick = 0;
+// ============================================================================
+// Tasks
+// ============================================================================
+static void pollButtonsTask()
+{
+    // Scan: debounce + FSM only, events go to the queue
+    inputEvents.tick(btnPlayPause, BTN_PLAY_PAUSE);
+    inputEvents.tick(btnReset, BTN_RESET);
+
+    // Handle every input event in one pass. Every debounced press gives a
+    // Press (also the second one of a double click) and ends in a Release,
+    // or a LongPressStop after a long press
+    ButtonEventRecord ev;
+    while (inputEvents.pop(ev)) {
+        bool pressed = (ev.event == ButtonEvent::Press);
+        bool released = (ev.event == ButtonEvent::Release || ev.event == ButtonEvent::LongPressStop);
+
+        if (ev.id == BTN_PLAY_PAUSE) {
+            // --- Handle Play/Pause button ---
+            if (pressed) {
+                btnStart.setPressed(true);
+                onPlayPauseClick();
+            } else if (released) {
+                btnStart.setPressed(false);
+                onPlayPauseRelease();
             }
-            GrStringDrawCentered(&sContext, "Running", -1, 64, 64, false);
         } else {
-            stopwatchTick = 0;
-            GrStringDrawCentered(&sContext, "Stopped", -1, 64, 64, false);
-        }
-
-        // --- Update screen if needed ---
-        currentMs = gStopwatchMs;
-        if (currentMs >= 1000){
-            currentSec += 1;
-            gStopwatchMs = 0;
-        }
-
-        if (currentSec >= 60){
-            currentMin += 1;
-            currentSec = 0;
-        }
-
-        if (currentMin >= 60){
-            currentHr += 1;
-            currentMin = 0;
-        }
-        if (currentHr >= 100){
-            gStopwatchMs = 0;
-            currentMs = 0;
-            currentSec = 0;
-            currentMin = 0;
-            currentHr = 0;
+            //--- Handle Reset button ---
+            if (pressed) {
+                btnClear.setPressed(true);
+                onResetClick();
+            } else if (released) {
+                btnClear.setPressed(false);
+            }
         }
+    }
+}
 
-        currentMs = currentMs % 1000;
-
-        if ((currentSec != lastDisplayedSec) ||
-            (gRunning != lastRunning) ||
-            (displayTick >= DISPLAY_REFRESH_MS)) {
-
-            drawStopwatchScreen(sContext, currentHr, currentMin, currentSec, currentMs, gRunning);
-            drawButton(sContext, btnStart);
-            drawButton(sContext, btnClear);
-
-            #ifdef GrFlush
-            GrFlush(&sContext);
-            #endif
+static void refreshScreenTask()
+{
+    // --- Laps recorded since the last refresh ---
+    LapRecorder<16>::Lap lap;
+    while (laps.poll(lap)) {
+        showLap(lap);
+    }
 
-            lastDisplayedSec = currentSec;
-            lastRunning = gRunning;
-            displayTick = 0;
-        }
+    // Only the widgets whose value changed draw, and only what they
+    // draw is sent to the LCD
+    updateStopwatchScreen();
+    if (updateWidgets(sContext, screenWidgets, SCREEN_WIDGET_COUNT)) {
+        #ifdef GrFlush
+        GrFlush(&sContext);
+        #endif
     }
 }
 
@@ -198,71 +199,76 @@ static void initializeDisplay(tContext &context)
 
 static void configureTimer(Timer &timer)
 {
-    timer.begin(gSystemClock, TIMER0_BASE);
+    // 64-bit wide timer: the stopwatch ticks never wrap
+    timer.begin(gSystemClock, WTIMER0_BASE);
+    idle.begin(TIMER1_BASE);
 }
 
 static void setupButtons()
 {
+    // Real time from the timer: gesture timing holds even when a
+    // redraw delays the button task
     btnPlayPause.begin();
-    btnPlayPause.setTickIntervalMs(BUTTON_TICK_MS);
+    btnPlayPause.setClock(timer);
     btnPlayPause.setDebounceMs(30);
 
     btnReset.begin();
-    btnReset.setTickIntervalMs(BUTTON_TICK_MS);
+    btnReset.setClock(timer);
     btnReset.setDebounceMs(30);
 }
 
+static void setupTasks()
+{
+    scheduler.every(BUTTON_TICK_MS, pollButtonsTask, 2);
+    scheduler.every(DISPLAY_REFRESH_MS, refreshScreenTask, 1);
+}
+
 // ============================================================================
 // Drawing functions
 // ============================================================================
-static void drawStopwatchScreen(tContext &context, uint32_t currentHr, uint32_t currentMin, uint32_t currentSec, uint32_t currentMs, bool running)
+static void updateStopwatchScreen()
 {
-    tRectangle rectFull = {0, 0, 127, 127};
-    GrContextForegroundSet(&context, ClrBlack);
-    GrRectFill(&context, &rectFull);
-
-    // === Draw title "STOPWATCH" at the top ===
-    GrContextForegroundSet(&context, ClrCyan);
-    GrStringDrawCentered(&context, "STOPWATCH", -1, 64, 15, false);
-
-    // Write "Running" or "Stopped"
-    if (running)
-    {
-        GrContextForegroundSet(&context, ClrCyan);
-        GrStringDrawCentered(&context, "Running", -1, 64, 30, false);
+    bool running = stopwatch.isRunning();
+    lblStatus.set(running);
+
+    // H:M:S:ms is only worked out here, from the accumulated ticks
+    Stopwatch::Time t = stopwatch.time();
+    const uint32_t fields[] = {t.hours % 100, t.minutes, t.seconds, t.millis};
+    if (timeFormat.update(timeText, fields)) {
+        fldTime.setText(timeText);
     }
-    else
-    {
-        GrContextForegroundSet(&context, ClrCyan);
-        GrStringDrawCentered(&context, "Stopped", -1, 64, 30, false);
-    }
-
-    // Draw seconds counter centered
-    char str[32];
-//    snprintf(str, sizeof(str), "%02u:%02u:%02u:%03", currentHr, currentMin, currentSec, currentMs);
-    snprintf(str, sizeof(str), "%02u:%02u:%02u:%03u",
-             (unsigned)currentHr, (unsigned)currentMin,
-             (unsigned)currentSec, (unsigned)currentMs);
-
-    GrContextForegroundSet(&context, running ? ClrYellow : ClrOlive);
-    GrStringDrawCentered(&context, str, -1, 64, 50, false);
+    fldTime.setColors(running ? ClrYellow : ClrOlive, ClrBlack);
 }
 
-static void drawButton(tContext &context, const MyButton &btn)
+// "<prefix>mm:ss:mmm" of a tick count into line
+static void formatLapLine(char *line, const char *prefix, uint64_t ticks)
 {
-    uint16_t bgColor = btn.pressed ? ClrBlack : ClrGray;
-    uint16_t textColor = btn.pressed ? ClrWhite : ClrBlack;
-
-    tRectangle rect = {btn.x, btn.y, btn.x + btn.w - 1, btn.y + btn.h - 1};
-    GrContextForegroundSet(&context, bgColor);
-    GrRectFill(&context, &rect);
-
-    GrContextForegroundSet(&context, ClrBlack);
-    GrRectDraw(&context, &rect);
+    while (*prefix) *line++ = *prefix++;
+    Stopwatch::Time t = Stopwatch::toTime(stopwatch.toMillis(ticks));
+    const uint32_t fields[] = {(t.hours * 60 + t.minutes) % 100, t.seconds, t.millis};
+    LapTimeFormat::format(line, fields);
+}
 
-    GrContextForegroundSet(&context, textColor);
-    GrStringDrawCentered(&context, btn.label, -1,
-                         btn.x + btn.w / 2, btn.y + btn.h / 2, false);
+// Adds a lap to the list and refreshes the statistics rows; the statistics
+// are kept up to date per lap, the history is never rescanned
+static void showLap(const LapRecorder<16>::Lap &lap)
+{
+    char line[TextList::MAX_CHARS + 1];
+    char prefix[] = "L00 ";
+    prefix[1] = static_cast<char>('0' + lap.number / 10 % 10);
+    prefix[2] = static_cast<char>('0' + lap.number % 10);
+    formatLapLine(line, prefix, lap.lap);
+    lstLaps.push(line);
+
+    const LapStats &stats = laps.stats();
+    formatLapLine(line, "min ", stats.min());
+    lstStats.setLine(0, line);
+    formatLapLine(line, "max ", stats.max());
+    lstStats.setLine(1, line);
+    formatLapLine(line, "avg ", static_cast<uint64_t>(stats.mean() + 0.5));
+    lstStats.setLine(2, line);
+    formatLapLine(line, "sd  ", static_cast<uint64_t>(stats.stddev() + 0.5));
+    lstStats.setLine(3, line);
 }
 
 // ============================================================================
@@ -270,8 +276,9 @@ static void drawButton(tContext &context, const MyButton &btn)
 // ============================================================================
 static void onPlayPauseClick()
 {
-    gRunning = !gRunning;
-    btnStart.label = gRunning ? "PAUSE" : "PLAY";
+    stopwatch.toggle();
+    btnStart.setLabel(stopwatch.isRunning() ? "PAUSE" : "PLAY");
+    btnClear.setLabel(stopwatch.isRunning() ? "LAP" : "RESET");
 }
 
 static void onPlayPauseRelease()
@@ -281,11 +288,14 @@ static void onPlayPauseRelease()
 
 static void onResetClick()
 {
-    //Set time on screen to 0
-    currentHr = 0;
-    currentMin = 0;
-    currentSec = 0;
-    currentMs = 0;
+    if (stopwatch.isRunning()) {
+        // Lap: only the split is taken here, the loop does the rest
+        laps.split(stopwatch.elapsedTicks());
+        return;
+    }
 
-    gStopwatchMs = 0;
+    stopwatch.reset();
+    laps.reset();
+    lstLaps.clear();
+    lstStats.clear();
 }
@@ -5,10 +5,13 @@
 // Las tablas port_to_base, digital_pin_to_port y digital_pin_to_bit_mask
 // son provistas por pins.h (incluido por button.h)
 
-Button::Button(uint8_t pin, uint32_t debounceTicks,
+ButtonCore::ButtonCore(uint8_t pin, uint32_t debounceTicks,
                              uint32_t longPressTicks, uint32_t doubleClickTicks,
                              ButtonPull pull)
-    : _pin(pin),
+    : _wasPressedFlag(false),
+      _wasReleasedFlag(false),
+      _currentPhysicalLevel(false),
+      _pin(pin),
       _pullMode(pull),
     _periph(0),
     _initialized(false),
@@ -28,12 +31,11 @@ Button::Button(uint8_t pin, uint32_t debounceTicks,
       _lastDuringLongPressTime(0),
       _nClicks(0),
     _maxClicks(2)
-        , _wasPressedFlag(false)
-        , _wasReleasedFlag(false)
-        , _currentPhysicalLevel(false)
         , _doubleClickedFlag(false)
         , _holdTimeMs(0)
-        , _releaseFunc(nullptr)
+        , _evClicks(0)
+        , _evHoldMs(0)
+        , _clock(nullptr)
 {
     uint8_t portIndex = digital_pin_to_port[_pin];
     _portBase = port_to_base[portIndex];
@@ -43,9 +45,12 @@ Button::Button(uint8_t pin, uint32_t debounceTicks,
     _periph = sysctl_periph_for_port(portIndex);
 }
 
-bool Button::readPhysical() {
+bool ButtonCore::readPhysical() {
     uint32_t v = GPIOPinRead(_portBase, _bitMask);
-    bool levelHigh = (v & _bitMask) != 0;
+    return activeFromPin((v & _bitMask) != 0);
+}
+
+bool ButtonCore::activeFromPin(bool levelHigh) const {
     // Si hay pull-up, consideramos el botón activo-bajo (presionado = 0)
     // Si hay pull-down, activo-alto (presionado = 1)
     if (_pullMode == ButtonPull::PullUp) {
@@ -58,7 +63,7 @@ bool Button::readPhysical() {
     }
 }
 
-void Button::applyPadConfig() {
+void ButtonCore::applyPadConfig() {
     if (_pullMode == ButtonPull::PullUp) {
         GPIOPadConfigSet(_portBase, _bitMask, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
     } else if (_pullMode == ButtonPull::PullDown) {
@@ -68,16 +73,14 @@ void Button::applyPadConfig() {
     }
 }
 
-void Button::setPull(ButtonPull pull) {
+void ButtonCore::setPull(ButtonPull pull) {
     _pullMode = pull;
     if (_initialized) applyPadConfig();
 }
 
 // Debounce similar a OneButton
-bool Button::debounce(bool value) {
-    // Avanza el reloj de software
-    _now += _tickIntervalMs;
-
+// (_now ya avanzado por quien llama)
+bool ButtonCore::debounce(bool value) {
     // No aplicar debounce al flanco a activo si _debounceMs < 0 (no usado aquí)
     if (value && _debounceMs < 0) {
         _debouncedLevel = value;
@@ -93,97 +96,85 @@ bool Button::debounce(bool value) {
     return _debouncedLevel;
 }
 
-void Button::newState(StateMachine next) {
-    _state = next;
+// Entrada: bit 1 = nivel activo (con debounce), bit 0 = plazo del estado
+// vencido (ver timedOut()). UP y PRESSEND no esperan: sus 4 columnas son iguales.
+#define S(x) ((uint8_t)StateMachine::x)
+const ButtonCore::Transition ButtonCore::kTransitions[6][4] = {
+    // OCS_INIT: idle tras _idleMs; pulsación
+    { { S(OCS_INIT),     0,                                   0 },
+      { S(OCS_INIT),     ACT_IDLE,                            BUTTON_EV_IDLE },
+      { S(OCS_DOWN),     ACT_START | ACT_NEW_PRESS,           BUTTON_EV_PRESS },
+      { S(OCS_DOWN),     ACT_IDLE | ACT_START | ACT_NEW_PRESS, BUTTON_EV_IDLE | BUTTON_EV_PRESS } },
+    // OCS_DOWN: soltar; long press tras _pressMs
+    { { S(OCS_UP),       ACT_HOLD | ACT_START,                BUTTON_EV_RELEASE },
+      { S(OCS_UP),       ACT_HOLD | ACT_START,                BUTTON_EV_RELEASE },
+      { S(OCS_DOWN),     0,                                   0 },
+      { S(OCS_PRESS),    0,                                   BUTTON_EV_LONG_PRESS_START } },
+    // OCS_UP: cuenta el click
+    { { S(OCS_COUNT),    ACT_COUNT,                           0 },
+      { S(OCS_COUNT),    ACT_COUNT,                           0 },
+      { S(OCS_COUNT),    ACT_COUNT,                           0 },
+      { S(OCS_COUNT),    ACT_COUNT,                           0 } },
+    // OCS_COUNT: otra pulsación (también emite press); fin de la ventana de click (o _maxClicks)
+    { { S(OCS_COUNT),    0,                                   0 },
+      { S(OCS_INIT),     ACT_CLICKS | ACT_RESET,              0 },
+      { S(OCS_DOWN),     ACT_START,                           BUTTON_EV_PRESS },
+      { S(OCS_DOWN),     ACT_START,                           BUTTON_EV_PRESS } },
+    // OCS_PRESS: soltar; DuringLongPress cada _longPressIntervalMs
+    { { S(OCS_PRESSEND), 0,                                   0 },
+      { S(OCS_PRESSEND), 0,                                   0 },
+      { S(OCS_PRESS),    0,                                   0 },
+      { S(OCS_PRESS),    ACT_DURING,                          BUTTON_EV_DURING_LONG_PRESS } },
+    // OCS_PRESSEND: fin del long press
+    { { S(OCS_INIT),     ACT_RESET,                           BUTTON_EV_LONG_PRESS_STOP },
+      { S(OCS_INIT),     ACT_RESET,                           BUTTON_EV_LONG_PRESS_STOP },
+      { S(OCS_INIT),     ACT_RESET,                           BUTTON_EV_LONG_PRESS_STOP },
+      { S(OCS_INIT),     ACT_RESET,                           BUTTON_EV_LONG_PRESS_STOP } },
+};
+#undef S
+
+// Plazo del estado actual (waitTime = _now - _startTime)
+bool ButtonCore::timedOut(unsigned long waitTime) const {
+    switch (_state) {
+    case StateMachine::OCS_INIT:  return !_idleState && (waitTime > _idleMs);
+    case StateMachine::OCS_DOWN:  return waitTime > _pressMs;
+    case StateMachine::OCS_COUNT: return (waitTime >= _clickMs) || (_nClicks == _maxClicks);
+    case StateMachine::OCS_PRESS: return (_now - _lastDuringLongPressTime) >= _longPressIntervalMs;
+    default:                      return false;
+    }
 }
 
-void Button::fsm(bool activeLevel) {
+uint16_t ButtonCore::fsm(bool activeLevel) {
     unsigned long waitTime = (_now - _startTime);
-
-    switch (_state) {
-    case StateMachine::OCS_INIT:
-        // Idle callback
-        if (!_idleState && (waitTime > _idleMs)) {
-            if (_idleFunc) _idleFunc();
-            _idleState = true;
-        }
-        if (activeLevel) {
-            newState(StateMachine::OCS_DOWN);
-            _startTime = _now;
-            _nClicks = 0;
-            if (_pressFunc) _pressFunc();
-            if (_paramPressFunc) _paramPressFunc(_pressFuncParam);
-            // Guardar tiempo de inicio de pulsación
-            _holdTimeMs = 0;
+    const Transition& t = kTransitions[(uint8_t)_state][(activeLevel ? 2 : 0) | (timedOut(waitTime) ? 1 : 0)];
+    uint16_t ev = t.events;
+    uint8_t act = t.actions;
+
+    _state = (StateMachine)t.next;
+    if (act) {
+        if (act & ACT_IDLE) _idleState = true;
+        if (act & ACT_HOLD) _holdTimeMs = waitTime;
+        if (act & ACT_START) _startTime = _now;
+        if (act & ACT_NEW_PRESS) { _nClicks = 0; _holdTimeMs = 0; }
+        if (act & ACT_COUNT) {
+            _nClicks++;
+            if (_nClicks == 2) _doubleClickedFlag = true;
         }
-        break;
-
-    case StateMachine::OCS_DOWN:
-        if (!activeLevel) {
-            newState(StateMachine::OCS_UP);
-            _startTime = _now;
-            // Calcular tiempo de pulsación
-            _holdTimeMs = _now - (_startTime - waitTime);
-            // Callback de release
-            if (_releaseFunc) _releaseFunc();
-        } else if (waitTime > _pressMs) {
-            if (_longPressStartFunc) _longPressStartFunc();
-            if (_paramLongPressStartFunc) _paramLongPressStartFunc(_longPressStartFuncParam);
-            newState(StateMachine::OCS_PRESS);
+        if (act & ACT_DURING) _lastDuringLongPressTime = _now;
+        if (act & ACT_CLICKS) {
+            ev |= (_nClicks == 1) ? BUTTON_EV_CLICK
+                : (_nClicks == 2) ? BUTTON_EV_DOUBLE_CLICK : BUTTON_EV_MULTI_CLICK;
+            _evClicks = (uint8_t)(_nClicks > 255 ? 255 : _nClicks);
         }
-        break;
-
-    case StateMachine::OCS_UP:
-        // Contar como click corto
-        _nClicks++;
-        if (_nClicks == 2) {
-            _doubleClickedFlag = true;
-        }
-        newState(StateMachine::OCS_COUNT);
-        break;
-
-    case StateMachine::OCS_COUNT:
-        if (activeLevel) {
-            newState(StateMachine::OCS_DOWN);
-            _startTime = _now;
-        } else if ((waitTime >= _clickMs) || (_nClicks == _maxClicks)) {
-            if (_nClicks == 1) {
-                if (_clickFunc) _clickFunc();
-                if (_paramClickFunc) _paramClickFunc(_clickFuncParam);
-            } else if (_nClicks == 2) {
-                if (_doubleClickFunc) _doubleClickFunc();
-                if (_paramDoubleClickFunc) _paramDoubleClickFunc(_doubleClickFuncParam);
-            } else {
-                if (_multiClickFunc) _multiClickFunc();
-                if (_paramMultiClickFunc) _paramMultiClickFunc(_multiClickFuncParam);
-            }
-            reset();
-        }
-        break;
-
-    case StateMachine::OCS_PRESS:
-        if (!activeLevel) {
-            newState(StateMachine::OCS_PRESSEND);
-        } else {
-            if ((_now - _lastDuringLongPressTime) >= _longPressIntervalMs) {
-                if (_duringLongPressFunc) _duringLongPressFunc();
-                if (_paramDuringLongPressFunc) _paramDuringLongPressFunc(_duringLongPressFuncParam);
-                _lastDuringLongPressTime = _now;
-            }
-        }
-        break;
-
-    case StateMachine::OCS_PRESSEND:
-        if (_longPressStopFunc) _longPressStopFunc();
-        if (_paramLongPressStopFunc) _paramLongPressStopFunc(_longPressStopFuncParam);
-        reset();
-        break;
+        if (act & ACT_RESET) reset();
+    }
+    if (ev & (BUTTON_EV_RELEASE | BUTTON_EV_LONG_PRESS_START | BUTTON_EV_DURING_LONG_PRESS | BUTTON_EV_LONG_PRESS_STOP)) {
+        _evHoldMs = waitTime;
     }
+    return ev;
 }
 
-void Button::tick() {
-    if (!_initialized) { begin(); }
-    bool physical = readPhysical();
+uint16_t ButtonCore::step(bool physical) {
     // Guardar el estado físico anterior
     bool prevPhysical = _currentPhysicalLevel;
     _currentPhysicalLevel = physical;
@@ -195,59 +186,32 @@ void Button::tick() {
     if (prevPhysical && !physical) {
         _wasReleasedFlag = true;
     }
-    // Debounce e índice de tiempo
     bool active = debounce(physical);
-    fsm(active);
+    return fsm(active);
 }
 
-void Button::tick(bool activeLevel) {
-    if (!_initialized) { begin(); }
-    bool prevPhysical = _currentPhysicalLevel;
-    _currentPhysicalLevel = activeLevel;
-    if (!prevPhysical && activeLevel) {
-        _wasPressedFlag = true;
-    }
-    if (prevPhysical && !activeLevel) {
-        _wasReleasedFlag = true;
-    }
-    bool active = debounce(activeLevel);
-    fsm(active);
+void Button::tick() {
+    ButtonCore::tick(static_cast<ButtonCallbacks<Button>&>(*this));
 }
 
-// Setters de tiempo
-void Button::setDebounceMs(int ms) { _debounceMs = ms; }
-void Button::setClickMs(unsigned int ms) { _clickMs = ms; }
-void Button::setPressMs(unsigned int ms) { _pressMs = ms; }
-void Button::setIdleMs(unsigned int ms) { _idleMs = ms; }
-void Button::setLongPressIntervalMs(unsigned int ms) { _longPressIntervalMs = ms; }
-void Button::setTickIntervalMs(unsigned int ms) { _tickIntervalMs = ms; }
-
-// Callbacks attach
-void Button::attachPress(callbackFunction fn) { _pressFunc = fn; }
-void Button::attachPress(parameterizedCallbackFunction fn, void* param) { _paramPressFunc = fn; _pressFuncParam = param; }
-
-void Button::attachClick(callbackFunction fn) { _clickFunc = fn; }
-void Button::attachClick(parameterizedCallbackFunction fn, void* param) { _paramClickFunc = fn; _clickFuncParam = param; }
-
-void Button::attachDoubleClick(callbackFunction fn) { _doubleClickFunc = fn; if (_maxClicks < 2) _maxClicks = 2; }
-void Button::attachDoubleClick(parameterizedCallbackFunction fn, void* param) { _paramDoubleClickFunc = fn; _doubleClickFuncParam = param; if (_maxClicks < 2) _maxClicks = 2; }
-
-void Button::attachMultiClick(callbackFunction fn) { _multiClickFunc = fn; if (_maxClicks < 100) _maxClicks = 100; }
-void Button::attachMultiClick(parameterizedCallbackFunction fn, void* param) { _paramMultiClickFunc = fn; _multiClickFuncParam = param; if (_maxClicks < 100) _maxClicks = 100; }
-
-void Button::attachLongPressStart(callbackFunction fn) { _longPressStartFunc = fn; }
-void Button::attachLongPressStart(parameterizedCallbackFunction fn, void* param) { _paramLongPressStartFunc = fn; _longPressStartFuncParam = param; }
-
-void Button::attachLongPressStop(callbackFunction fn) { _longPressStopFunc = fn; }
-void Button::attachLongPressStop(parameterizedCallbackFunction fn, void* param) { _paramLongPressStopFunc = fn; _longPressStopFuncParam = param; }
+void Button::tick(bool activeLevel) {
+    ButtonCore::tick(activeLevel, static_cast<ButtonCallbacks<Button>&>(*this));
+}
 
-void Button::attachDuringLongPress(callbackFunction fn) { _duringLongPressFunc = fn; }
-void Button::attachDuringLongPress(parameterizedCallbackFunction fn, void* param) { _paramDuringLongPressFunc = fn; _duringLongPressFuncParam = param; }
+void Button::tick(ButtonEdgeCapture& edges) {
+    ButtonCore::tick(edges, static_cast<ButtonCallbacks<Button>&>(*this));
+}
 
-void Button::attachIdle(callbackFunction fn) { _idleFunc = fn; }
+// Setters de tiempo
+void ButtonCore::setDebounceMs(int ms) { _debounceMs = ms; }
+void ButtonCore::setClickMs(unsigned int ms) { _clickMs = ms; }
+void ButtonCore::setPressMs(unsigned int ms) { _pressMs = ms; }
+void ButtonCore::setIdleMs(unsigned int ms) { _idleMs = ms; }
+void ButtonCore::setLongPressIntervalMs(unsigned int ms) { _longPressIntervalMs = ms; }
+void ButtonCore::setTickIntervalMs(unsigned int ms) { _tickIntervalMs = ms; }
 
 // Utilidades
-void Button::reset() {
+void ButtonCore::reset() {
     _state = StateMachine::OCS_INIT;
     _nClicks = 0;
     _startTime = _now;
@@ -258,47 +222,42 @@ void Button::reset() {
     _holdTimeMs = 0;
 }
 
-int Button::getNumberClicks() const { return _nClicks; }
-bool Button::isIdle() const { return _state == StateMachine::OCS_INIT; }
-bool Button::isLongPressed() const { return _state == StateMachine::OCS_PRESS; }
+int ButtonCore::getNumberClicks() const { return _nClicks; }
+bool ButtonCore::isIdle() const { return _state == StateMachine::OCS_INIT; }
+bool ButtonCore::isLongPressed() const { return _state == StateMachine::OCS_PRESS; }
 
 // Nuevo método: Devuelve true si el botón fue presionado desde la última consulta y resetea la bandera
-bool Button::wasPressed() {
+bool ButtonCore::wasPressed() {
     bool ret = _wasPressedFlag;
     _wasPressedFlag = false;
     return ret;
 }
 
 // Nuevo método: Devuelve true si el botón está presionado actualmente
-bool Button::isPressed() const {
+bool ButtonCore::isPressed() const {
     return _currentPhysicalLevel;
 }
 
 // Nuevo método: Devuelve true si el botón fue soltado desde la última consulta y resetea la bandera
-bool Button::wasReleased() {
+bool ButtonCore::wasReleased() {
     bool ret = _wasReleasedFlag;
     _wasReleasedFlag = false;
     return ret;
 }
 
 // Nuevo método: Devuelve true si hubo doble clic desde la última consulta y resetea la bandera
-bool Button::isDoubleClicked() {
+bool ButtonCore::isDoubleClicked() {
     bool ret = _doubleClickedFlag;
     _doubleClickedFlag = false;
     return ret;
 }
 
-// Nuevo método: Permite registrar un callback para el evento de soltado
-void Button::attachRelease(callbackFunction fn) {
-    _releaseFunc = fn;
-}
-
 // Nuevo método: Devuelve el tiempo en ms que el botón estuvo presionado en la última pulsación
-unsigned int Button::getHoldTime() const {
+unsigned int ButtonCore::getHoldTime() const {
     return _holdTimeMs;
 }
 
-void Button::begin() {
+void ButtonCore::begin() {
     if (_initialized) return;
     if (_periph != 0) {
         SysCtlPeripheralEnable(_periph);
@@ -308,3 +267,98 @@ void Button::begin() {
     }
     _initialized = true;
 }
+
+// Capturas de flancos, una lista por puerto (índice de pins.h)
+static ButtonEdgeCapture* s_edgeCaptures[NUM_PORTS];
+
+template <uint8_t P>
+void ButtonEdgeCapture::portIsr(void)
+{
+    uint32_t base = port_to_base[P];
+    uint32_t status = GPIOIntStatus(base, true);
+    GPIOIntClear(base, status);
+    uint32_t levels = GPIOPinRead(base, 0xFF);
+    for (ButtonEdgeCapture* c = s_edgeCaptures[P]; c; c = c->_next) {
+        c->onEdgeIsr(status, levels);
+    }
+}
+
+bool ButtonEdgeCapture::attach(ButtonCore& button)
+{
+    uint8_t port = digital_pin_to_port[button._pin];
+    void (*handler)(void);
+    switch (port) {
+        case PA: handler = portIsr<PA>; break;
+        case PB: handler = portIsr<PB>; break;
+        case PC: handler = portIsr<PC>; break;
+        case PD: handler = portIsr<PD>; break;
+        case PE: handler = portIsr<PE>; break;
+        case PF: handler = portIsr<PF>; break;
+        case PG: handler = portIsr<PG>; break;
+        case PH: handler = portIsr<PH>; break;
+        case PJ: handler = portIsr<PJ>; break;
+        case PK: handler = portIsr<PK>; break;
+        case PL: handler = portIsr<PL>; break;
+        case PM: handler = portIsr<PM>; break;
+        case PN: handler = portIsr<PN>; break;
+        default: handler = nullptr; break;
+    }
+
+    // Reutilizada en otro puerto: sale de la lista del anterior, cuya ISR ya
+    // no la recorre con su status y sus niveles
+    if (_button && (_port != port || !handler)) {
+        ButtonEdgeCapture** link = &s_edgeCaptures[_port];
+        while (*link && *link != this) link = &(*link)->_next;
+        if (*link) *link = _next;
+        _next = nullptr;
+        _button = nullptr;
+    }
+    if (!handler) return false;
+
+    _button = &button;
+    _port = port;
+    for (ButtonEdgeCapture* c = s_edgeCaptures[port]; c; c = c->_next) {
+        if (c == this) return true;
+    }
+    // Enlazar antes de publicar: la ISR puede recorrer la lista en cualquier momento
+    _next = s_edgeCaptures[port];
+    s_edgeCaptures[port] = this;
+    GPIOIntRegister(port_to_base[port], handler);   // también la habilita en el NVIC
+    return true;
+}
+
+void ButtonEdgeCapture::onEdgeIsr(uint32_t status, uint32_t portLevels) {
+    ButtonCore& b = *_button;
+    if (!(status & b._bitMask)) return;
+    ButtonEdge e = {b._clock->ticks(), b._pin, b.activeFromPin((portLevels & b._bitMask) != 0)};
+    _edges.push(e);
+}
+
+void ButtonCore::setClock(Timer& clock) {
+    _clock = &clock;
+
+    // Tiempos relativos al reloj real desde ahora
+    _now = (unsigned long)clock.toMillis(clock.ticks());
+    _startTime = _now;
+    _lastDebounceTime = _now;
+}
+
+bool ButtonCore::beginInterrupt(ButtonEdgeCapture& edges, Timer& clock) {
+    begin();
+    if (_periph == 0) return false;
+
+    setClock(clock);
+    edges._edges.clear();
+
+    GPIOIntDisable(_portBase, _bitMask);
+    GPIOIntTypeSet(_portBase, _bitMask, GPIO_BOTH_EDGES);
+    GPIOIntClear(_portBase, _bitMask);
+    // Si el puerto no admite interrupción, tick(edges) sigue en sondeo con tiempo real
+    if (!edges.attach(*this)) return false;
+
+    // Nivel inicial como primer registro, igual que la primera lectura en sondeo
+    ButtonEdge e = {clock.ticks(), _pin, readPhysical()};
+    edges._edges.push(e);
+    GPIOIntEnable(_portBase, _bitMask);
+    return true;
+}
@@ -3,8 +3,94 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <type_traits>
 #include "driverlib/gpio.h"
 #include "pins.h"        // Energia pin mapping for TM4C1294XL
+#include "timerLib.h"
+
+// Flanco capturado por la ISR del puerto (modo interrupción)
+struct ButtonEdge {
+    uint64_t tick;   // Timer::ticks() al atender el flanco
+    uint8_t  pin;    // pin Energia
+    bool     level;  // nivel lógico tras el flanco (true = presionado)
+};
+
+// Cola circular productor único (ISR del puerto) / consumidor único (tick())
+// sin bloqueo: cada índice lo escribe un solo lado.
+template <uint32_t N>
+class ButtonEdgeRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    ButtonEdgeRing() : _head(0), _tail(0), _dropped(0) {}
+
+    // Productor: false (y cuenta el descarte) si la cola está llena
+    bool push(const ButtonEdge& e) {
+        uint32_t head = _head;
+        if (head - _tail == N) { _dropped = _dropped + 1; return false; }
+        uint32_t i = head & (N - 1);
+        _tick[i] = e.tick;
+        _pin[i] = e.pin;
+        _level[i] = e.level;
+        _head = head + 1;                 // publica el registro ya escrito
+        return true;
+    }
+
+    // Consumidor: false si la cola está vacía
+    bool pop(ButtonEdge& e) {
+        uint32_t tail = _tail;
+        if (_head == tail) return false;
+        uint32_t i = tail & (N - 1);
+        e.tick = _tick[i];
+        e.pin = _pin[i];
+        e.level = _level[i];
+        _tail = tail + 1;                 // libera la celda ya leída
+        return true;
+    }
+
+    void clear() { _tail = _head; }
+    uint32_t size() const { return _head - _tail; }
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    volatile uint64_t _tick[N];
+    volatile uint8_t  _pin[N];
+    volatile bool     _level[N];
+    volatile uint32_t _head;     // solo lo escribe la ISR
+    volatile uint32_t _tail;     // solo lo escribe tick()
+    volatile uint32_t _dropped;  // solo lo escribe la ISR
+};
+
+class ButtonCore;
+
+// Captura de flancos de un botón en modo interrupción, aparte del botón:
+// los botones en sondeo no cargan la cola ni el enlace de la ISR.
+//   Button btn(USR_SW1);
+//   ButtonEdgeCapture btnEdges;
+//   btn.beginInterrupt(btnEdges, timer);
+//   btn.tick(btnEdges);          // periódico; consume los flancos
+// Una captura sirve a un solo botón: beginInterrupt() con otro botón, de
+// cualquier puerto, se la pasa (y la mueve a la ISR de su puerto).
+class ButtonEdgeCapture {
+public:
+    static constexpr uint32_t QUEUE = 16;
+
+    ButtonEdgeCapture() : _button(nullptr), _next(nullptr), _port(0) {}
+
+    uint32_t dropped() const { return _edges.dropped(); }  // flancos perdidos por cola llena
+
+private:
+    friend class ButtonCore;
+
+    bool attach(ButtonCore& button);   // enlaza en la lista de la ISR del puerto (y la saca de la del botón anterior)
+    void onEdgeIsr(uint32_t status, uint32_t portLevels);
+    template <uint8_t P> static void portIsr(void);
+
+    ButtonEdgeRing<QUEUE> _edges;
+    ButtonCore* _button;               // nullptr hasta beginInterrupt()
+    ButtonEdgeCapture* _next;          // siguiente captura del mismo puerto
+    uint8_t _port;                     // puerto de la lista en que está enlazada
+};
 
 enum class ButtonPull {
     PullUp,
@@ -12,31 +98,66 @@ enum class ButtonPull {
     None,
 };
 
-class Button {
+// Eventos de un paso de la FSM, como bits. Varios en el mismo paso se
+// disparan en el orden de los bits (solo idle + press pueden coincidir).
+enum ButtonEventBit : uint16_t {
+    BUTTON_EV_IDLE              = 1u << 0,
+    BUTTON_EV_PRESS             = 1u << 1,  // cada pulsación, también la 2.ª de un doble click
+    BUTTON_EV_RELEASE           = 1u << 2,
+    BUTTON_EV_LONG_PRESS_START  = 1u << 3,
+    BUTTON_EV_DURING_LONG_PRESS = 1u << 4,
+    BUTTON_EV_CLICK             = 1u << 5,
+    BUTTON_EV_DOUBLE_CLICK      = 1u << 6,
+    BUTTON_EV_MULTI_CLICK       = 1u << 7,
+    BUTTON_EV_LONG_PRESS_STOP   = 1u << 8,
+};
+
+// Núcleo del botón: pin, debounce, FSM y modo interrupción, sin callbacks.
+// La FSM devuelve los eventos de cada paso y tick(sink) se los pasa a
+// sink.dispatch(eventos). Lo usan:
+// - Button: callbacks en tiempo de ejecución (attach*, estilo OneButton).
+// - ButtonT<Derived>: handlers resueltos en compilación (CRTP); los eventos
+//   sin handler no ocupan memoria ni generan comparaciones.
+class ButtonCore {
 public:
-    // Nuevas variables de estado fsico y eventos
+    // Nuevas variables de estado físico y eventos
     bool _wasPressedFlag;
     bool _wasReleasedFlag;
     bool _currentPhysicalLevel;
 
-    // Tipos de callback compatibles con OneButton
-    typedef void (*callbackFunction)(void);
-    typedef void (*parameterizedCallbackFunction)(void*);
-
     // Nota: el constructor habilita automáticamente el reloj del puerto GPIO
     // asociado al pin, espera a que el periférico esté listo y configura el
     // pin como entrada con pull-up interno (activo-bajo), usando el mapeo
     // de Energia provisto en pins.h.
     // Los parámetros en "ticks" se convierten a ms usando _tickIntervalMs (por defecto 20 ms)
-    Button(uint8_t pin, uint32_t debounceTicks = 3,
-           uint32_t longPressTicks = 50, uint32_t doubleClickTicks = 25,
-           ButtonPull pull = ButtonPull::PullUp);
+    ButtonCore(uint8_t pin, uint32_t debounceTicks = 3,
+               uint32_t longPressTicks = 50, uint32_t doubleClickTicks = 25,
+               ButtonPull pull = ButtonPull::PullUp);
 
-    // Bucle de sondeo
-    void tick();                 // llamado periódicamente cada ~_tickIntervalMs
-    void tick(bool activeLevel); // tick con nivel lógico (true=presionado)
+    // Bucle de sondeo: un paso por tick, eventos a sink.dispatch(uint16_t)
+    template <class Sink> void tick(Sink& sink);
+    template <class Sink> void tick(bool activeLevel, Sink& sink);
     void begin();                // habilita reloj GPIO y configura el pin (llamar tras configurar el clock del MCU)
 
+    // Tiempo real: tick() toma el tiempo de 'clock' en lugar de sumar
+    // _tickIntervalMs, así que debounce, ventanas de click/long press y
+    // getHoldTime() miden el tiempo transcurrido aunque tick() llegue tarde
+    // o a intervalos irregulares (p.ej. tras un flush bloqueante). Resolución
+    // de 1 ms; el resto de la API no cambia.
+    void setClock(Timer& clock);
+
+    // Modo interrupción: la ISR del puerto (ambos flancos) guarda cada flanco
+    // con su tick de 'clock' en la cola de 'edges', y tick(edges) los consume
+    // con su tiempo real en lugar de sumar _tickIntervalMs. Una pulsación más
+    // corta que el periodo de tick() no se pierde (si supera el debounce).
+    // tick(edges) se sigue llamando periódicamente para los tiempos de
+    // click/long press; sin beginInterrupt() hace lo mismo que tick().
+    // Puertos A..N (P y Q tienen interrupción por pin); requiere
+    // IntMasterEnable(). wasPressed()/wasReleased() siguen el nivel físico,
+    // que aquí incluye cada rebote: usar los callbacks (con debounce).
+    bool beginInterrupt(ButtonEdgeCapture& edges, Timer& clock);
+    template <class Sink> void tick(ButtonEdgeCapture& edges, Sink& sink);
+
     // API de estado
     void setPull(ButtonPull pull);     // reconfigurar pull en tiempo de ejecución
 
@@ -48,29 +169,9 @@ public:
     void setLongPressIntervalMs(unsigned int ms);
     void setTickIntervalMs(unsigned int ms);
 
-    // Registro de callbacks — estilo OneButton
-    void attachPress(callbackFunction fn);
-    void attachPress(parameterizedCallbackFunction fn, void* param);
-
-    void attachClick(callbackFunction fn);
-    void attachClick(parameterizedCallbackFunction fn, void* param);
-
-    void attachDoubleClick(callbackFunction fn);
-    void attachDoubleClick(parameterizedCallbackFunction fn, void* param);
-
-    void attachMultiClick(callbackFunction fn);
-    void attachMultiClick(parameterizedCallbackFunction fn, void* param);
-
-    void attachLongPressStart(callbackFunction fn);
-    void attachLongPressStart(parameterizedCallbackFunction fn, void* param);
-
-    void attachLongPressStop(callbackFunction fn);
-    void attachLongPressStop(parameterizedCallbackFunction fn, void* param);
-
-    void attachDuringLongPress(callbackFunction fn);
-    void attachDuringLongPress(parameterizedCallbackFunction fn, void* param);
-
-    void attachIdle(callbackFunction fn);
+    // Clicks que cierran la cuenta sin esperar a _clickMs (2 por defecto;
+    // 100 para recibir multi-click)
+    void setMaxClicks(int n) { if (_maxClicks < n) _maxClicks = n; }
 
     // Utilidades
     void reset();
@@ -85,20 +186,47 @@ public:
 
     // Nuevas funciones avanzadas
     bool isDoubleClicked(); // Devuelve true si hubo doble clic desde la última consulta y resetea la bandera
-    void attachRelease(callbackFunction fn); // Registra un callback para el evento de soltado
     unsigned int getHoldTime() const; // Devuelve el tiempo en ms que el botón estuvo presionado en la última pulsación
 
+    // Datos del último paso, para dispatch() (p.ej. ButtonEventQueue)
+    unsigned long nowMs() const { return _now; }              // tiempo del botón (ms)
+    uint8_t eventClicks() const { return _evClicks; }         // clicks del último Click/DoubleClick/MultiClick
+    unsigned int eventHoldMs() const { return _evHoldMs; }    // ms presionado en el último Release/LongPress*
+
 private:
-    // Máquina de estados tipo OneButton
-    enum class StateMachine : int {
+    friend class ButtonEdgeCapture;
+    friend class ButtonBank;     // usa kTransitions con el estado de cada bit
+
+    // Máquina de estados tipo OneButton (índice de la tabla de transiciones)
+    enum class StateMachine : uint8_t {
         OCS_INIT = 0,
         OCS_DOWN = 1,
         OCS_UP = 2,
         OCS_COUNT = 3,
-        OCS_PRESS = 6,
-        OCS_PRESSEND = 7,
+        OCS_PRESS = 4,
+        OCS_PRESSEND = 5,
     };
 
+    // Acciones de una transición, en este orden
+    enum : uint8_t {
+        ACT_IDLE      = 1u << 0,   // _idleState = true
+        ACT_HOLD      = 1u << 1,   // _holdTimeMs = tiempo presionado
+        ACT_START     = 1u << 2,   // _startTime = _now
+        ACT_NEW_PRESS = 1u << 3,   // primera pulsación: _nClicks = 0, _holdTimeMs = 0
+        ACT_COUNT     = 1u << 4,   // _nClicks++ (bandera de doble click en el 2.º)
+        ACT_DURING    = 1u << 5,   // _lastDuringLongPressTime = _now
+        ACT_CLICKS    = 1u << 6,   // Click / DoubleClick / MultiClick según _nClicks
+        ACT_RESET     = 1u << 7,   // reset()
+    };
+
+    // Entrada de la tabla: estado siguiente, acciones (ACT_*) y eventos
+    struct Transition {
+        uint8_t  next;
+        uint8_t  actions;
+        uint16_t events;
+    };
+    static const Transition kTransitions[6][4];
+
     // Hardware mapping
     uint8_t  _pin;
     uint32_t _portBase;
@@ -129,13 +257,147 @@ private:
 
     // Lectura/config de hardware
     bool readPhysical();
+    bool activeFromPin(bool levelHigh) const;
     void applyPadConfig();
 
-    // Lógica FSM + debounce
-    void fsm(bool activeLevel);
-    void newState(StateMachine next);
+    // Avanza _now: tiempo de _clock o reloj de software
+    void advanceTime() {
+        if (_clock) _now = (unsigned long)_clock->toMillis(_clock->ticks());
+        else _now += _tickIntervalMs;
+    }
+
+    // Lógica FSM + debounce; devuelven los eventos del paso
+    uint16_t step(bool physical);  // flancos, debounce y FSM en _now
+    uint16_t fsm(bool activeLevel);
+    bool timedOut(unsigned long waitTime) const;
     bool debounce(bool value);
 
+    // Variables para nuevas funciones
+    bool _doubleClickedFlag;
+    unsigned int _holdTimeMs;
+    uint8_t _evClicks;
+    unsigned int _evHoldMs;
+
+    // Tiempo real (setClock, beginInterrupt)
+    Timer* _clock;               // nullptr = tiempo por _tickIntervalMs
+};
+
+template <class Sink>
+void ButtonCore::tick(Sink& sink) {
+    if (!_initialized) { begin(); }
+    advanceTime();
+    sink.dispatch(step(readPhysical()));
+}
+
+template <class Sink>
+void ButtonCore::tick(ButtonEdgeCapture& edges, Sink& sink) {
+    // Sin beginInterrupt() (o puerto sin interrupción): sondeo
+    if (edges._button != this) { tick(sink); return; }
+
+    // Modo interrupción: consume la cola
+    ButtonEdge e;
+    for (;;) {
+        while (edges._edges.pop(e)) {
+            _now = (unsigned long)_clock->toMillis(e.tick);
+            // El nivel anterior se mantuvo hasta el flanco: se evalúa en ese
+            // instante y después se aplica el nivel nuevo
+            sink.dispatch(step(_currentPhysicalLevel));
+            sink.dispatch(step(e.level));
+        }
+        uint64_t now = _clock->ticks();
+        // Un flanco entre la última pop() y la lectura del timer tiene un
+        // tick anterior a 'now': se consume antes de avanzar hasta 'now'
+        if (edges._edges.size() == 0) {
+            _now = (unsigned long)_clock->toMillis(now);
+            sink.dispatch(step(_currentPhysicalLevel));
+            return;
+        }
+    }
+}
+
+template <class Sink>
+void ButtonCore::tick(bool activeLevel, Sink& sink) {
+    if (!_initialized) { begin(); }
+    advanceTime();
+    sink.dispatch(step(activeLevel));
+}
+
+// Callbacks en tiempo de ejecución, estilo OneButton (Self: la clase final,
+// derivada también de ButtonCore)
+template <class Self>
+class ButtonCallbacks {
+public:
+    // Tipos de callback compatibles con OneButton
+    typedef void (*callbackFunction)(void);
+    typedef void (*parameterizedCallbackFunction)(void*);
+
+    // Registro de callbacks — estilo OneButton
+    void attachPress(callbackFunction fn) { _pressFunc = fn; }
+    void attachPress(parameterizedCallbackFunction fn, void* param) { _paramPressFunc = fn; _pressFuncParam = param; }
+
+    void attachClick(callbackFunction fn) { _clickFunc = fn; }
+    void attachClick(parameterizedCallbackFunction fn, void* param) { _paramClickFunc = fn; _clickFuncParam = param; }
+
+    void attachDoubleClick(callbackFunction fn) { _doubleClickFunc = fn; self().setMaxClicks(2); }
+    void attachDoubleClick(parameterizedCallbackFunction fn, void* param) { _paramDoubleClickFunc = fn; _doubleClickFuncParam = param; self().setMaxClicks(2); }
+
+    void attachMultiClick(callbackFunction fn) { _multiClickFunc = fn; self().setMaxClicks(100); }
+    void attachMultiClick(parameterizedCallbackFunction fn, void* param) { _paramMultiClickFunc = fn; _multiClickFuncParam = param; self().setMaxClicks(100); }
+
+    void attachLongPressStart(callbackFunction fn) { _longPressStartFunc = fn; }
+    void attachLongPressStart(parameterizedCallbackFunction fn, void* param) { _paramLongPressStartFunc = fn; _longPressStartFuncParam = param; }
+
+    void attachLongPressStop(callbackFunction fn) { _longPressStopFunc = fn; }
+    void attachLongPressStop(parameterizedCallbackFunction fn, void* param) { _paramLongPressStopFunc = fn; _longPressStopFuncParam = param; }
+
+    void attachDuringLongPress(callbackFunction fn) { _duringLongPressFunc = fn; }
+    void attachDuringLongPress(parameterizedCallbackFunction fn, void* param) { _paramDuringLongPressFunc = fn; _duringLongPressFuncParam = param; }
+
+    void attachIdle(callbackFunction fn) { _idleFunc = fn; }
+    void attachRelease(callbackFunction fn) { _releaseFunc = fn; } // Registra un callback para el evento de soltado
+
+    // Uso interno: llamado por ButtonCore::tick() con los eventos de cada paso
+    void dispatch(uint16_t ev) {
+        if (!ev) return;
+        if (ev & BUTTON_EV_IDLE) {
+            if (_idleFunc) _idleFunc();
+        }
+        if (ev & BUTTON_EV_PRESS) {
+            if (_pressFunc) _pressFunc();
+            if (_paramPressFunc) _paramPressFunc(_pressFuncParam);
+        }
+        if (ev & BUTTON_EV_RELEASE) {
+            if (_releaseFunc) _releaseFunc();
+        }
+        if (ev & BUTTON_EV_LONG_PRESS_START) {
+            if (_longPressStartFunc) _longPressStartFunc();
+            if (_paramLongPressStartFunc) _paramLongPressStartFunc(_longPressStartFuncParam);
+        }
+        if (ev & BUTTON_EV_DURING_LONG_PRESS) {
+            if (_duringLongPressFunc) _duringLongPressFunc();
+            if (_paramDuringLongPressFunc) _paramDuringLongPressFunc(_duringLongPressFuncParam);
+        }
+        if (ev & BUTTON_EV_CLICK) {
+            if (_clickFunc) _clickFunc();
+            if (_paramClickFunc) _paramClickFunc(_clickFuncParam);
+        }
+        if (ev & BUTTON_EV_DOUBLE_CLICK) {
+            if (_doubleClickFunc) _doubleClickFunc();
+            if (_paramDoubleClickFunc) _paramDoubleClickFunc(_doubleClickFuncParam);
+        }
+        if (ev & BUTTON_EV_MULTI_CLICK) {
+            if (_multiClickFunc) _multiClickFunc();
+            if (_paramMultiClickFunc) _paramMultiClickFunc(_multiClickFuncParam);
+        }
+        if (ev & BUTTON_EV_LONG_PRESS_STOP) {
+            if (_longPressStopFunc) _longPressStopFunc();
+            if (_paramLongPressStopFunc) _paramLongPressStopFunc(_longPressStopFuncParam);
+        }
+    }
+
+private:
+    Self& self() { return static_cast<Self&>(*this); }
+
     // Callbacks registrados
     callbackFunction _pressFunc = nullptr;
     parameterizedCallbackFunction _paramPressFunc = nullptr; void* _pressFuncParam = nullptr;
@@ -159,10 +421,76 @@ private:
     parameterizedCallbackFunction _paramDuringLongPressFunc = nullptr; void* _duringLongPressFuncParam = nullptr;
 
     callbackFunction _idleFunc = nullptr;
-    // Variables para nuevas funciones
-    bool _doubleClickedFlag;
-    unsigned int _holdTimeMs;
-    callbackFunction _releaseFunc;
+    callbackFunction _releaseFunc = nullptr;
+};
+
+// Botón con callbacks en tiempo de ejecución (API de siempre)
+class Button : public ButtonCore, public ButtonCallbacks<Button> {
+public:
+    Button(uint8_t pin, uint32_t debounceTicks = 3,
+           uint32_t longPressTicks = 50, uint32_t doubleClickTicks = 25,
+           ButtonPull pull = ButtonPull::PullUp)
+        : ButtonCore(pin, debounceTicks, longPressTicks, doubleClickTicks, pull) {}
+
+    void tick();                 // llamado periódicamente cada ~_tickIntervalMs
+    void tick(bool activeLevel); // tick con nivel lógico (true=presionado)
+    void tick(ButtonEdgeCapture& edges);  // modo interrupción (beginInterrupt)
+};
+
+// Despacho estático: llama a los on*() de d de los eventos en ev (ButtonT, JoystickT)
+template <class Handler>
+inline void dispatchButtonEvents(Handler& d, uint16_t ev) {
+    if (ev & BUTTON_EV_IDLE)              d.onIdle();
+    if (ev & BUTTON_EV_PRESS)             d.onPress();
+    if (ev & BUTTON_EV_RELEASE)           d.onRelease();
+    if (ev & BUTTON_EV_LONG_PRESS_START)  d.onLongPressStart();
+    if (ev & BUTTON_EV_DURING_LONG_PRESS) d.onDuringLongPress();
+    if (ev & BUTTON_EV_CLICK)             d.onClick();
+    if (ev & BUTTON_EV_DOUBLE_CLICK)      d.onDoubleClick();
+    if (ev & BUTTON_EV_MULTI_CLICK)       d.onMultiClick();
+    if (ev & BUTTON_EV_LONG_PRESS_STOP)   d.onLongPressStop();
+}
+
+// Botón con handlers en compilación (CRTP). Derived oculta los on*() que
+// necesita; los demás quedan vacíos y el compilador elimina su comparación.
+//   struct PlayButton : ButtonT<PlayButton> {
+//       using ButtonT::ButtonT;
+//       void onClick() { stopwatch.toggle(); }
+//   };
+// Definir onMultiClick() equivale a attachMultiClick() (setMaxClicks(100)).
+template <class Derived>
+class ButtonT : public ButtonCore {
+public:
+    ButtonT(uint8_t pin, uint32_t debounceTicks = 3,
+            uint32_t longPressTicks = 50, uint32_t doubleClickTicks = 25,
+            ButtonPull pull = ButtonPull::PullUp)
+        : ButtonCore(pin, debounceTicks, longPressTicks, doubleClickTicks, pull) {
+        if (!std::is_same<decltype(&Derived::onMultiClick), void (ButtonT::*)()>::value) setMaxClicks(100);
+    }
+
+    void tick()                 { ButtonCore::tick(*this); }
+    void tick(bool activeLevel) { ButtonCore::tick(activeLevel, *this); }
+    void tick(ButtonEdgeCapture& edges) { ButtonCore::tick(edges, *this); }
+
+    // Handlers por defecto: no hacen nada
+    void onIdle() {}
+    void onPress() {}
+    void onRelease() {}
+    void onLongPressStart() {}
+    void onDuringLongPress() {}
+    void onClick() {}
+    void onDoubleClick() {}
+    void onMultiClick() {}
+    void onLongPressStop() {}
+
+    // Uso interno: llamado por ButtonCore::tick() con los eventos de cada paso
+    void dispatch(uint16_t ev) { dispatchButtonEvents(static_cast<Derived&>(*this), ev); }
+};
+
+// Botón sin callbacks: solo estado (wasPressed(), isPressed(), ...)
+class SimpleButton : public ButtonT<SimpleButton> {
+public:
+    using ButtonT::ButtonT;
 };
 
 #endif
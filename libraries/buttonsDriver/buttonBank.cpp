@@ -0,0 +1,155 @@
+#include "buttonBank.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+
+ButtonBank::ButtonBank(uint8_t port, uint8_t pins, ButtonPull pull)
+    : _port(port),
+      _portBase(port_to_base[port]),
+      _pins(pins),
+      _activeLow(pull == ButtonPull::PullDown ? 0x00 : 0xFF),
+      _pullMode(pull),
+      _debounced(0),
+      _cnt0(0), _cnt1(0), _cnt2(0),
+      _debounceMs(60),
+      _clickMs(500),
+      _pressMs(1000),
+      _longPressIntervalMs(0),
+      _tickIntervalMs(20),
+      _now(0),
+      _busy(0),
+      _maxClicks(2),
+      _pressFunc(nullptr),
+      _releaseFunc(nullptr),
+      _clickFunc(nullptr),
+      _doubleClickFunc(nullptr),
+      _multiClickFunc(nullptr),
+      _longPressStartFunc(nullptr),
+      _duringLongPressFunc(nullptr),
+      _longPressStopFunc(nullptr)
+{
+    for (uint8_t i = 0; i < 8; i++) {
+        _state[i] = OCS_INIT;
+        _nClicks[i] = 0;
+        _startTime[i] = 0;
+        _lastDuringLongPressTime[i] = 0;
+    }
+    updateDebounceTicks();
+}
+
+void ButtonBank::begin() {
+    uint32_t periph = sysctl_periph_for_port(_port);
+    if (periph == 0) return;
+    SysCtlPeripheralEnable(periph);
+    while (!SysCtlPeripheralReady(periph)) { }
+    GPIOPinTypeGPIOInput(_portBase, _pins);
+    if (_pullMode == ButtonPull::PullUp) {
+        GPIOPadConfigSet(_portBase, _pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPU);
+    } else if (_pullMode == ButtonPull::PullDown) {
+        GPIOPadConfigSet(_portBase, _pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD_WPD);
+    } else {
+        GPIOPadConfigSet(_portBase, _pins, GPIO_STRENGTH_2MA, GPIO_PIN_TYPE_STD);
+    }
+}
+
+void ButtonBank::setDebounceMs(unsigned int ms) { _debounceMs = ms; updateDebounceTicks(); }
+void ButtonBank::setTickIntervalMs(unsigned int ms) { _tickIntervalMs = ms; updateDebounceTicks(); }
+
+// Button acepta un cambio cuando el nivel se mantiene (_now - cambio) >= _debounceMs,
+// es decir N = max(1, ceil(debounce / tick)) ticks después de la muestra del
+// cambio: N + 1 muestras iguales seguidas
+void ButtonBank::updateDebounceTicks() {
+    unsigned int n = _tickIntervalMs ? (_debounceMs + _tickIntervalMs - 1) / _tickIntervalMs : 1;
+    if (n < 1) n = 1;
+    if (n > MAX_DEBOUNCE_TICKS) n = MAX_DEBOUNCE_TICKS;
+    uint8_t target = (uint8_t)(n + 1);
+    _tgt0 = (target & 1) ? 0xFF : 0x00;
+    _tgt1 = (target & 2) ? 0xFF : 0x00;
+    _tgt2 = (target & 4) ? 0xFF : 0x00;
+}
+
+void ButtonBank::tick() {
+    tick((uint8_t)GPIOPinRead(_portBase, _pins));
+}
+
+void ButtonBank::tick(uint8_t portLevels) {
+    uint8_t raw = (uint8_t)((portLevels ^ _activeLow) & _pins);
+
+    // Contador vertical: +1 donde la muestra difiere del nivel aceptado,
+    // 0 donde coincide (la racha de muestras distintas se cortó)
+    uint8_t diff = raw ^ _debounced;
+    uint8_t c0 = _cnt0, c1 = _cnt1;
+    _cnt2 = (uint8_t)((_cnt2 ^ (c0 & c1)) & diff);
+    _cnt1 = (uint8_t)((c1 ^ c0) & diff);
+    _cnt0 = (uint8_t)(~c0 & diff);
+
+    // Bits cuyo contador llegó a N + 1: aceptan el nivel nuevo
+    uint8_t hit = (uint8_t)(diff & ~(_cnt0 ^ _tgt0) & ~(_cnt1 ^ _tgt1) & ~(_cnt2 ^ _tgt2));
+    _debounced ^= hit;
+    _cnt0 &= (uint8_t)~hit;
+    _cnt1 &= (uint8_t)~hit;
+    _cnt2 &= (uint8_t)~hit;
+
+    _now += _tickIntervalMs;
+
+    // FSM solo para bits presionados o a mitad de un gesto; en OCS_INIT y
+    // sin presionar la FSM de Button no hace nada
+    uint8_t run = (uint8_t)((_busy | _debounced) & _pins);
+    for (uint8_t bit = 0; run; bit++, run >>= 1) {
+        if (run & 1) fsm(bit, (_debounced >> bit) & 1);
+    }
+}
+
+void ButtonBank::reset(uint8_t bit) {
+    _state[bit] = OCS_INIT;
+    _nClicks[bit] = 0;
+    _startTime[bit] = _now;
+}
+
+// Plazo del estado de un bit, como ButtonCore::timedOut() (el banco no
+// tiene idle: OCS_INIT no vence nunca)
+bool ButtonBank::timedOut(uint8_t bit, unsigned long waitTime) const {
+    switch (_state[bit]) {
+    case OCS_DOWN:  return waitTime > _pressMs;
+    case OCS_COUNT: return (waitTime >= _clickMs) || (_nClicks[bit] == _maxClicks);
+    case OCS_PRESS: return (_now - _lastDuringLongPressTime[bit]) >= _longPressIntervalMs;
+    default:        return false;
+    }
+}
+
+// La tabla de ButtonCore::fsm con el estado de un bit. ACT_IDLE no sale
+// (timedOut() en OCS_INIT es false) y ACT_HOLD no aplica: sin getHoldTime()
+void ButtonBank::fsm(uint8_t bit, bool activeLevel) {
+    unsigned long waitTime = (_now - _startTime[bit]);
+    const ButtonCore::Transition& t =
+        ButtonCore::kTransitions[_state[bit]][(activeLevel ? 2 : 0) | (timedOut(bit, waitTime) ? 1 : 0)];
+    uint16_t ev = t.events;
+    uint8_t act = t.actions;
+
+    _state[bit] = t.next;
+    if (act) {
+        if (act & ButtonCore::ACT_START) _startTime[bit] = _now;
+        if (act & ButtonCore::ACT_NEW_PRESS) _nClicks[bit] = 0;
+        if (act & ButtonCore::ACT_COUNT) _nClicks[bit]++;
+        if (act & ButtonCore::ACT_DURING) _lastDuringLongPressTime[bit] = _now;
+        if (act & ButtonCore::ACT_CLICKS) {
+            ev |= (_nClicks[bit] == 1) ? BUTTON_EV_CLICK
+                : (_nClicks[bit] == 2) ? BUTTON_EV_DOUBLE_CLICK : BUTTON_EV_MULTI_CLICK;
+        }
+        if (act & ButtonCore::ACT_RESET) reset(bit);
+    }
+
+    // Callbacks en el orden de los bits de evento, como ButtonCallbacks::dispatch()
+    if (ev) {
+        if ((ev & BUTTON_EV_PRESS) && _pressFunc) _pressFunc(bit);
+        if ((ev & BUTTON_EV_RELEASE) && _releaseFunc) _releaseFunc(bit);
+        if ((ev & BUTTON_EV_LONG_PRESS_START) && _longPressStartFunc) _longPressStartFunc(bit);
+        if ((ev & BUTTON_EV_DURING_LONG_PRESS) && _duringLongPressFunc) _duringLongPressFunc(bit);
+        if ((ev & BUTTON_EV_CLICK) && _clickFunc) _clickFunc(bit);
+        if ((ev & BUTTON_EV_DOUBLE_CLICK) && _doubleClickFunc) _doubleClickFunc(bit);
+        if ((ev & BUTTON_EV_MULTI_CLICK) && _multiClickFunc) _multiClickFunc(bit);
+        if ((ev & BUTTON_EV_LONG_PRESS_STOP) && _longPressStopFunc) _longPressStopFunc(bit);
+    }
+
+    if (_state[bit] == OCS_INIT) _busy &= (uint8_t)~(1u << bit);
+    else                         _busy |= (uint8_t)(1u << bit);
+}
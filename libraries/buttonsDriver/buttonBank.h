@@ -0,0 +1,119 @@
+#ifndef BUTTON_BANK_H
+#define BUTTON_BANK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "button.h"      // ButtonPull y pins.h
+
+// Banco de hasta 8 botones de un mismo puerto GPIO
+// Una sola lectura GPIOPinRead() por tick para todo el puerto, y el debounce
+// de los 8 bits en paralelo con contadores verticales: el bit i del contador
+// está repartido en tres bytes (_cnt0.._cnt2), así que contar, comparar y
+// reiniciar los 8 contadores son unas pocas operaciones lógicas de 8 bits.
+// La FSM de click/doble click/long press (la tabla de Button) solo corre
+// para los bits cuyo nivel con debounce cambió o que están a mitad de un
+// gesto; un banco en reposo cuesta la lectura y el debounce.
+// Mismos tiempos y eventos que Button con tick(bool) al mismo periodo,
+// salvo el callback de idle, que el banco no tiene.
+// Uso típico:
+//   ButtonBank keys(PL, GPIO_PIN_1 | GPIO_PIN_2);
+//   keys.begin();
+//   keys.attachClick(onKeyClick);            // void onKeyClick(uint8_t bit)
+//   while (true) { keys.tick(); delay 20 ms }
+
+class ButtonBank {
+public:
+    // Callbacks con el número de bit (0..7) del botón
+    typedef void (*callbackFunction)(uint8_t bit);
+
+    // Máximo de ticks de debounce (contador vertical de 3 bits: N + 1 <= 7)
+    static constexpr uint8_t MAX_DEBOUNCE_TICKS = 6;
+
+    // port: índice de puerto de pins.h (PA..PQ); pins: máscara GPIO_PIN_x
+    ButtonBank(uint8_t port, uint8_t pins, ButtonPull pull = ButtonPull::PullUp);
+
+    void begin();                // habilita reloj GPIO y configura los pines
+
+    // Un tick para todo el banco (cada ~_tickIntervalMs)
+    void tick();                 // lee el puerto
+    void tick(uint8_t portLevels); // con los niveles crudos del puerto (p.ej. de una matriz)
+
+    // Configuración de tiempos (ms), como en Button. El debounce se cuenta
+    // en ticks, max(1, ceil(ms / tick)), y se recorta a MAX_DEBOUNCE_TICKS:
+    // con un tick de 20 ms, hasta 120 ms; más, se queda en 120 ms.
+    void setDebounceMs(unsigned int ms);
+    void setClickMs(unsigned int ms) { _clickMs = ms; }
+    void setPressMs(unsigned int ms) { _pressMs = ms; }
+    void setLongPressIntervalMs(unsigned int ms) { _longPressIntervalMs = ms; }
+    void setTickIntervalMs(unsigned int ms);
+
+    // Callbacks (comunes a todos los bits)
+    void attachPress(callbackFunction fn) { _pressFunc = fn; }
+    void attachRelease(callbackFunction fn) { _releaseFunc = fn; }
+    void attachClick(callbackFunction fn) { _clickFunc = fn; }
+    void attachDoubleClick(callbackFunction fn) { _doubleClickFunc = fn; if (_maxClicks < 2) _maxClicks = 2; }
+    void attachMultiClick(callbackFunction fn) { _multiClickFunc = fn; if (_maxClicks < 100) _maxClicks = 100; }
+    void attachLongPressStart(callbackFunction fn) { _longPressStartFunc = fn; }
+    void attachDuringLongPress(callbackFunction fn) { _duringLongPressFunc = fn; }
+    void attachLongPressStop(callbackFunction fn) { _longPressStopFunc = fn; }
+
+    // Estado
+    uint8_t pressed() const { return _debounced; }        // niveles con debounce (1 = presionado)
+    uint8_t busy() const { return _busy; }                // bits a mitad de un gesto
+    int getNumberClicks(uint8_t bit) const { return _nClicks[bit]; }
+    bool isLongPressed(uint8_t bit) const { return _state[bit] == OCS_PRESS; }
+
+private:
+    // Estados de la FSM: índices de ButtonCore::kTransitions
+    typedef ButtonCore::StateMachine StateMachine;
+    enum : uint8_t {
+        OCS_INIT     = (uint8_t)StateMachine::OCS_INIT,
+        OCS_DOWN     = (uint8_t)StateMachine::OCS_DOWN,
+        OCS_COUNT    = (uint8_t)StateMachine::OCS_COUNT,
+        OCS_PRESS    = (uint8_t)StateMachine::OCS_PRESS,
+    };
+
+    void fsm(uint8_t bit, bool activeLevel);
+    bool timedOut(uint8_t bit, unsigned long waitTime) const;
+    void reset(uint8_t bit);
+    void updateDebounceTicks();
+
+    // Hardware
+    uint8_t  _port;
+    uint32_t _portBase;
+    uint8_t  _pins;
+    uint8_t  _activeLow;        // bits que se invierten (pull-up: activo-bajo)
+    ButtonPull _pullMode;
+
+    // Debounce vertical
+    uint8_t _debounced;         // nivel con debounce
+    uint8_t _cnt0, _cnt1, _cnt2; // contador por bit: muestras seguidas != _debounced
+    uint8_t _tgt0, _tgt1, _tgt2; // N + 1 (muestras para aceptar un cambio) en planos: 0x00 o 0xFF
+    unsigned int _debounceMs;
+
+    // Temporización (ms)
+    unsigned int _clickMs;
+    unsigned int _pressMs;
+    unsigned int _longPressIntervalMs;
+    unsigned int _tickIntervalMs;
+    unsigned long _now;
+
+    // FSM por bit
+    uint8_t _busy;              // bits con _state != OCS_INIT
+    uint8_t _state[8];          // StateMachine
+    uint8_t _nClicks[8];
+    unsigned long _startTime[8];
+    unsigned long _lastDuringLongPressTime[8];
+    int _maxClicks;
+
+    callbackFunction _pressFunc;
+    callbackFunction _releaseFunc;
+    callbackFunction _clickFunc;
+    callbackFunction _doubleClickFunc;
+    callbackFunction _multiClickFunc;
+    callbackFunction _longPressStartFunc;
+    callbackFunction _duringLongPressFunc;
+    callbackFunction _longPressStopFunc;
+};
+
+#endif
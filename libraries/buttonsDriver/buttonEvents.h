@@ -0,0 +1,153 @@
+#ifndef BUTTON_EVENTS_H
+#define BUTTON_EVENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "button.h"
+
+// Cola de eventos de botones
+// El escaneo (tarea o ISR periódica) hace tick() de cada botón a través de
+// la cola, y sus eventos entran como registros con el id del botón, el
+// tiempo y los datos del gesto. La aplicación los saca todos en una pasada
+// con pop(), fuera del escaneo, en lugar de consultar banderas botón por
+// botón o ejecutar callbacks dentro de tick().
+// Cola productor único / consumidor único sin bloqueo (como SplitRing):
+// el escaneo puede correr en una ISR y el consumo en el bucle principal.
+// Uso típico:
+//   enum : uint8_t { BTN_PLAY, BTN_RESET };
+//   ButtonEventQueue<16> input;
+//   input.tick(btnPlay, BTN_PLAY);              // escaneo
+//   input.tick(btnReset, BTN_RESET);
+//   ButtonEventRecord r;
+//   while (input.pop(r)) { /* r.id, r.event, ... */ }
+
+// Evento de botón (mismo orden que los bits BUTTON_EV_*)
+enum class ButtonEvent : uint8_t {
+    Idle = 0,
+    Press,
+    Release,
+    LongPressStart,
+    DuringLongPress,
+    Click,
+    DoubleClick,
+    MultiClick,
+    LongPressStop,
+};
+
+struct ButtonEventRecord {
+    uint32_t    timeMs;   // tiempo del botón (ms) al producirse
+    uint32_t    holdMs;   // ms presionado: Release y LongPress*; 0 en el resto
+    uint8_t     id;       // id dado en tick()
+    ButtonEvent event;
+    uint8_t     clicks;   // clicks: Click, DoubleClick y MultiClick; 0 en el resto
+};
+
+template <uint32_t N>
+class ButtonEventQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    ButtonEventQueue() : _head(0), _tail(0), _dropped(0) {}
+
+    // Escaneo: un tick del botón (sondeo o modo interrupción); sus eventos
+    // entran en la cola con el id dado. Cualquier botón sobre ButtonCore
+    // (Button, ButtonT, SimpleButton); los callbacks propios no se llaman.
+    void tick(ButtonCore& button, uint8_t id) {
+        Sink sink = { *this, button, id };
+        button.tick(sink);
+    }
+
+    // Igual, en modo interrupción (ButtonCore::beginInterrupt)
+    void tick(ButtonCore& button, uint8_t id, ButtonEdgeCapture& edges) {
+        Sink sink = { *this, button, id };
+        button.tick(edges, sink);
+    }
+
+    // Igual, con el nivel lógico (true = presionado)
+    void tick(ButtonCore& button, uint8_t id, bool activeLevel) {
+        Sink sink = { *this, button, id };
+        button.tick(activeLevel, sink);
+    }
+
+    // Productor: false (y cuenta el descarte) si la cola está llena
+    bool push(const ButtonEventRecord& r) {
+        uint32_t head = _head;
+        if (head - _tail == N) { _dropped = _dropped + 1; return false; }
+        uint32_t i = head & (N - 1);
+        _timeMs[i] = r.timeMs;
+        _holdMs[i] = r.holdMs;
+        _id[i] = r.id;
+        _event[i] = (uint8_t)r.event;
+        _clicks[i] = r.clicks;
+        _head = head + 1;                 // publica el registro ya escrito
+        return true;
+    }
+
+    // Consumidor: false si la cola está vacía
+    bool pop(ButtonEventRecord& r) {
+        uint32_t tail = _tail;
+        if (_head == tail) return false;
+        uint32_t i = tail & (N - 1);
+        r.timeMs = _timeMs[i];
+        r.holdMs = _holdMs[i];
+        r.id = _id[i];
+        r.event = (ButtonEvent)_event[i];
+        r.clicks = _clicks[i];
+        _tail = tail + 1;                 // libera la celda ya leída
+        return true;
+    }
+
+    // Consumidor: descarta lo pendiente
+    void clear() { _tail = _head; }
+
+    uint32_t size() const { return _head - _tail; }
+    uint32_t dropped() const { return _dropped; }
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    // Destino de ButtonCore::tick(): un registro por bit, en orden
+    struct Sink {
+        ButtonEventQueue& queue;
+        ButtonCore& button;
+        uint8_t id;
+
+        void dispatch(uint16_t ev) {
+            for (uint8_t e = 0; ev; e++, ev >>= 1) {
+                if (!(ev & 1u)) continue;
+                ButtonEventRecord r;
+                r.timeMs = (uint32_t)button.nowMs();
+                r.id = id;
+                r.event = (ButtonEvent)e;
+                r.holdMs = 0;
+                r.clicks = 0;
+                switch (r.event) {
+                case ButtonEvent::Release:
+                case ButtonEvent::LongPressStart:
+                case ButtonEvent::DuringLongPress:
+                case ButtonEvent::LongPressStop:
+                    r.holdMs = button.eventHoldMs();
+                    break;
+                case ButtonEvent::Click:
+                case ButtonEvent::DoubleClick:
+                case ButtonEvent::MultiClick:
+                    r.clicks = button.eventClicks();
+                    break;
+                default:
+                    break;
+                }
+                queue.push(r);
+            }
+        }
+    };
+
+    volatile uint32_t _timeMs[N];
+    volatile uint32_t _holdMs[N];
+    volatile uint8_t  _id[N];
+    volatile uint8_t  _event[N];
+    volatile uint8_t  _clicks[N];
+    volatile uint32_t _head;     // solo lo escribe el escaneo
+    volatile uint32_t _tail;     // solo lo escribe el consumidor
+    volatile uint32_t _dropped;  // solo lo escribe el escaneo
+};
+
+#endif
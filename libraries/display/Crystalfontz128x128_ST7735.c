@@ -42,6 +42,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "grlib/grlib.h"
 #include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
 
@@ -50,7 +51,70 @@ uint16_t Lcd_ScreenWidth, Lcd_ScreenHeigth;
 uint8_t Lcd_PenSolid, Lcd_FontSolid, Lcd_FlagRead;
 uint16_t Lcd_TouchTrim;
 
-uint16_t Lcd_buffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX] = {0}; // Gene Bogdanov: LCD frame buffer in RAM
+#if LCD_DOUBLE_BUFFER
+static LCD_BUFFER_TYPE Lcd_frames[2][LCD_BUFFER_ROWS][LCD_BUFFER_WIDTH];
+LCD_BUFFER_TYPE (*Lcd_buffer)[LCD_BUFFER_WIDTH] = Lcd_frames[0]; // back buffer, grlib draws here
+static LCD_BUFFER_TYPE (*Lcd_front)[LCD_BUFFER_WIDTH] = Lcd_frames[1]; // front buffer, being sent
+#else
+LCD_BUFFER_TYPE Lcd_buffer[LCD_BUFFER_ROWS][LCD_BUFFER_WIDTH] = {0}; // Gene Bogdanov: LCD frame buffer in RAM
+#endif
+
+#if LCD_BAND_ROWS
+// Screen row held in Lcd_buffer[0], and the strip height RenderBands uses
+static int32_t Lcd_bandY0;
+static uint32_t Lcd_bandRows = LCD_BAND_ROWS;
+#define LCD_BUFFER_ROW(y)     Lcd_buffer[(y) - Lcd_bandY0]
+#else
+#define LCD_BUFFER_ROW(y)     Lcd_buffer[y]
+#endif
+
+// Byte offset of pixel x within a frame buffer row
+#define LCD_ROW_OFFSET(x)     ((x) * LCD_BPP / 8)
+// Pixels per 32-bit word, and a word filled with one pixel value
+#define LCD_PIXELS_PER_WORD   (32 / LCD_BPP)
+#define LCD_FILL_WORD(v)      ((uint32_t)(v) * (0xffffffffu / ((1u << LCD_BPP) - 1)))
+
+#if LCD_BPP != 16
+// Index 0 is black, which is what the cleared frame buffer shows. Entries
+// past Lcd_paletteCount are free for ColorTranslate to allocate.
+uint16_t Lcd_palette[LCD_PALETTE_SIZE];
+static uint32_t Lcd_paletteCount = 1;
+#endif
+
+// Dirty span of each frame buffer row, inclusive. A row is clean when
+// Lcd_dirtyXMin > Lcd_dirtyXMax. Only dirty rows are sent by the flush.
+static uint8_t Lcd_dirtyXMin[LCD_VERTICAL_MAX];
+static uint8_t Lcd_dirtyXMax[LCD_VERTICAL_MAX];
+
+// Rectangles collected from the dirty spans by the last flush
+#define LCD_MAX_WINDOWS 16
+typedef struct
+{
+    uint8_t x0, y0, x1, y1;
+    uint8_t pui8Caset[4]; // CASET/RASET parameters, used by the asynchronous flush
+    uint8_t pui8Raset[4];
+} tLcdWindow;
+static tLcdWindow Lcd_windows[LCD_MAX_WINDOWS];
+static uint32_t Lcd_windowCount;
+
+// Asynchronous flush state: CASET, RASET and RAMWR steps for each window
+static tLcdTransfer Lcd_transfers[3 * LCD_MAX_WINDOWS];
+static uint8_t Lcd_flushMode = LCD_DOUBLE_BUFFER ? LCD_FLUSH_ASYNC : LCD_FLUSH_BLOCKING;
+static void (*Lcd_pfnFlushDone)(void);
+static volatile bool Lcd_flushBusy;
+
+// Translated entries of the 4 or 8 bpp image palette PixelDrawMultiple used
+// last, each filled the first time an image pixel refers to it
+static const uint8_t *Lcd_imagePalette;
+static uint32_t Lcd_imagePaletteValid[256 / 32];
+static LCD_BUFFER_TYPE Lcd_imagePaletteNative[256];
+
+// Controller initialization parameters, sent with HAL_LCD_writeDataBurst()
+static const uint8_t Lcd_initGamset[] = {0x04};
+static const uint8_t Lcd_initPwctr[]  = {0x0A, 0x14};
+static const uint8_t Lcd_initStba[]   = {0x0A, 0x00};
+static const uint8_t Lcd_initColmod[] = {0x05};
+static const uint8_t Lcd_initMadctl[] = {CM_MADCTL_BGR};
 
 static void Crystalfontz128x128_Flush(void *pvDisplayData);
 static uint32_t Crystalfontz128x128_ColorTranslate(void *pvDisplayData, uint32_t ulValue);
@@ -67,6 +131,8 @@ static uint32_t Crystalfontz128x128_ColorTranslate(void *pvDisplayData, uint32_t
 //*****************************************************************************
 void Crystalfontz128x128_Init(void)
 {
+    uint8_t flushMode;
+
     HAL_LCD_PortInit();
     HAL_LCD_SpiInit();
 
@@ -74,22 +140,20 @@ void Crystalfontz128x128_Init(void)
     HAL_LCD_delay(120000);
 
     HAL_LCD_writeCommand(CM_GAMSET);
-    HAL_LCD_writeData(0x04);
+    HAL_LCD_writeDataBurst(Lcd_initGamset, sizeof(Lcd_initGamset));
 
     HAL_LCD_writeCommand(CM_SETPWCTR);
-    HAL_LCD_writeData(0x0A);
-    HAL_LCD_writeData(0x14);
+    HAL_LCD_writeDataBurst(Lcd_initPwctr, sizeof(Lcd_initPwctr));
 
     HAL_LCD_writeCommand(CM_SETSTBA);
-    HAL_LCD_writeData(0x0A);
-    HAL_LCD_writeData(0x00);
+    HAL_LCD_writeDataBurst(Lcd_initStba, sizeof(Lcd_initStba));
 
     HAL_LCD_writeCommand(CM_COLMOD);
-    HAL_LCD_writeData(0x05);
+    HAL_LCD_writeDataBurst(Lcd_initColmod, sizeof(Lcd_initColmod));
     HAL_LCD_delay(10);
 
     HAL_LCD_writeCommand(CM_MADCTL);
-    HAL_LCD_writeData(CM_MADCTL_BGR);
+    HAL_LCD_writeDataBurst(Lcd_initMadctl, sizeof(Lcd_initMadctl));
 
     HAL_LCD_writeCommand(CM_NORON);
 
@@ -100,14 +164,29 @@ void Crystalfontz128x128_Init(void)
     Lcd_FlagRead  = 0;
     Lcd_TouchTrim = 0;
 
+    Crystalfontz128x128_Invalidate(); // LCD memory contents are unknown after reset
+    flushMode = Lcd_flushMode; // LCD memory must be written before the display is turned on
+    Lcd_flushMode = LCD_FLUSH_BLOCKING;
+#if LCD_BAND_ROWS
+    Crystalfontz128x128_RenderBands(0, 0); // clear the LCD memory one strip at a time
+#else
     Crystalfontz128x128_Flush(0); // Gene Bogdanov: flush the RAM buffer instead of filling LCD memory with fixed values
+#endif
+    Lcd_flushMode = flushMode;
 
     HAL_LCD_delay(10);
     HAL_LCD_writeCommand(CM_DISPON);
 }
 
 
-void Crystalfontz128x128_SetDrawFrame(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+//*****************************************************************************
+//
+// Builds the CASET and RASET parameter bytes for a draw frame, applying the
+// panel offset of the current orientation.
+//
+//*****************************************************************************
+static void Crystalfontz128x128_FrameParams(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1,
+                                            uint8_t *pui8Caset, uint8_t *pui8Raset)
 {
     switch (Lcd_Orientation) {
         case 0:
@@ -138,17 +217,28 @@ void Crystalfontz128x128_SetDrawFrame(uint32_t x0, uint32_t y0, uint32_t x1, uin
             break;
     }
 
+    pui8Caset[0] = (uint8_t)(x0 >> 8);
+    pui8Caset[1] = (uint8_t)(x0);
+    pui8Caset[2] = (uint8_t)(x1 >> 8);
+    pui8Caset[3] = (uint8_t)(x1);
+
+    pui8Raset[0] = (uint8_t)(y0 >> 8);
+    pui8Raset[1] = (uint8_t)(y0);
+    pui8Raset[2] = (uint8_t)(y1 >> 8);
+    pui8Raset[3] = (uint8_t)(y1);
+}
+
+
+void Crystalfontz128x128_SetDrawFrame(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1)
+{
+    uint8_t pui8Caset[4], pui8Raset[4];
+    Crystalfontz128x128_FrameParams(x0, y0, x1, y1, pui8Caset, pui8Raset);
+
     HAL_LCD_writeCommand(CM_CASET);
-    HAL_LCD_writeData((uint8_t)(x0 >> 8));
-    HAL_LCD_writeData((uint8_t)(x0));
-    HAL_LCD_writeData((uint8_t)(x1 >> 8));
-    HAL_LCD_writeData((uint8_t)(x1));
+    HAL_LCD_writeDataBurst(pui8Caset, sizeof(pui8Caset));
 
     HAL_LCD_writeCommand(CM_RASET);
-    HAL_LCD_writeData((uint8_t)(y0 >> 8));
-    HAL_LCD_writeData((uint8_t)(y0));
-    HAL_LCD_writeData((uint8_t)(y1 >> 8));
-    HAL_LCD_writeData((uint8_t)(y1));
+    HAL_LCD_writeDataBurst(pui8Raset, sizeof(pui8Raset));
 }
 
 
@@ -170,6 +260,7 @@ void Crystalfontz128x128_SetDrawFrame(uint32_t x0, uint32_t y0, uint32_t x1, uin
 void Crystalfontz128x128_SetOrientation(uint8_t orientation)
 {
     Lcd_Orientation = orientation;
+    Crystalfontz128x128_Invalidate(); // LCD memory must be rewritten in the new scan direction
     HAL_LCD_writeCommand(CM_MADCTL);
     switch (Lcd_Orientation) {
         case LCD_ORIENTATION_UP:
@@ -188,6 +279,211 @@ void Crystalfontz128x128_SetOrientation(uint8_t orientation)
 }
 
 
+//*****************************************************************************
+//
+//! Marks the whole frame buffer as dirty.
+//!
+//! The next flush sends the entire frame buffer to the display. Call this
+//! after writing to Lcd_buffer[] directly instead of through grlib.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_Invalidate(void)
+{
+    int i;
+    for (i = 0; i < LCD_VERTICAL_MAX; i++) {
+        Lcd_dirtyXMin[i] = 0;
+        Lcd_dirtyXMax[i] = LCD_HORIZONTAL_MAX - 1;
+    }
+}
+
+
+//*****************************************************************************
+//
+//! Selects how grlib's flush sends the frame buffer.
+//!
+//! \param mode is one of:
+//!           - \b LCD_FLUSH_BLOCKING, the flush returns once all dirty
+//!             rectangles have been sent (default),
+//!           - \b LCD_FLUSH_ASYNC, the flush queues the dirty rectangles and
+//!             returns immediately; the SSI TX interrupt sends them.
+//! \param pfnDone is called from interrupt context when an asynchronous
+//! flush completes, or NULL.
+//!
+//! While an asynchronous flush is in progress, drawing into a row that has
+//! not been sent yet waits until the transfer has passed that row. Drawing
+//! from pfnDone is allowed; drawing from other interrupt handlers is not.
+//!
+//! With \b LCD_DOUBLE_BUFFER the flush swaps the back and front buffers
+//! first, so drawing never waits for the transfer and the asynchronous mode
+//! is the default. The next flush waits for the previous one to finish.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SetFlushMode(uint8_t mode, void (*pfnDone)(void))
+{
+    while (Lcd_flushBusy);
+    Lcd_flushMode = mode;
+    Lcd_pfnFlushDone = pfnDone;
+}
+
+
+//*****************************************************************************
+//
+//! Returns true while an asynchronous flush is sending the frame buffer.
+//
+//*****************************************************************************
+bool Crystalfontz128x128_IsFlushBusy(void)
+{
+    return Lcd_flushBusy;
+}
+
+
+#if !LCD_DOUBLE_BUFFER && !LCD_BAND_ROWS
+//*****************************************************************************
+//
+// Returns the first frame buffer row an asynchronous flush has not sent yet.
+//
+//*****************************************************************************
+static int32_t Crystalfontz128x128_PendingRow(void)
+{
+    uint32_t pos = HAL_LCD_transferPosition();
+    uint32_t step = HAL_LCD_TRANSFER_STEP(pos);
+    const tLcdWindow *psWindow = &Lcd_windows[step / 3];
+
+    if (step / 3 >= Lcd_windowCount) return LCD_VERTICAL_MAX;
+    if (step % 3 != 2) return psWindow->y0; // draw frame not set up yet
+    return psWindow->y0 + HAL_LCD_TRANSFER_ROW(pos);
+}
+#endif
+
+
+//*****************************************************************************
+//
+// Extends the dirty spans of rows lY1..lY2 to include columns lX1..lX2.
+// Every primitive calls this before writing to the frame buffer, so with a
+// single frame buffer it also holds off drawing into rows an asynchronous
+// flush still has to send. In banded mode the strips are sent whole and
+// there is nothing to track.
+//
+//*****************************************************************************
+static inline void Crystalfontz128x128_MarkDirty(int32_t lX1, int32_t lX2,
+                                                 int32_t lY1, int32_t lY2)
+{
+#if !LCD_BAND_ROWS
+#if !LCD_DOUBLE_BUFFER
+    while (Lcd_flushBusy &&
+           lY1 <= Lcd_windows[Lcd_windowCount - 1].y1 &&
+           lY2 >= Crystalfontz128x128_PendingRow());
+#endif
+#if LCD_BPP == 4
+    lX1 &= ~1; // spans cover whole bytes
+    lX2 |= 1;
+#endif
+
+    for (; lY1 <= lY2; lY1++) {
+        if (lX1 < Lcd_dirtyXMin[lY1]) Lcd_dirtyXMin[lY1] = lX1;
+        if (lX2 > Lcd_dirtyXMax[lY1]) Lcd_dirtyXMax[lY1] = lX2;
+    }
+#endif
+}
+
+
+//*****************************************************************************
+//
+// Stores one pixel value in the frame buffer.
+//
+//*****************************************************************************
+static inline void Crystalfontz128x128_PutPixel(int32_t lX, int32_t lY, uint32_t ulValue)
+{
+#if LCD_BPP == 4
+    uint8_t *pui8Byte = &LCD_BUFFER_ROW(lY)[lX >> 1];
+    *pui8Byte = (lX & 1) ? ((*pui8Byte & 0xf0) | ulValue) : ((*pui8Byte & 0x0f) | (ulValue << 4));
+#else
+    LCD_BUFFER_ROW(lY)[lX] = ulValue;
+#endif
+}
+
+
+//*****************************************************************************
+//
+// Fills pixels lX1..lX2 of row lY with the pixel value repeated in ulFill
+// (see LCD_FILL_WORD), a 32-bit word at a time between the unaligned ends.
+//
+//*****************************************************************************
+static inline void Crystalfontz128x128_FillSpan(int32_t lX1, int32_t lX2, int32_t lY,
+                                                uint32_t ulFill)
+{
+    uint32_t ulValue = ulFill & ((1u << LCD_BPP) - 1);
+    uint32_t *pWrite;
+
+    for (; (lX1 & (LCD_PIXELS_PER_WORD - 1)) && lX1 <= lX2; lX1++) {
+        Crystalfontz128x128_PutPixel(lX1, lY, ulValue);
+    }
+    for (; ((lX2 + 1) & (LCD_PIXELS_PER_WORD - 1)) && lX2 >= lX1; lX2--) {
+        Crystalfontz128x128_PutPixel(lX2, lY, ulValue);
+    }
+
+    pWrite = (uint32_t *)((uint8_t *)LCD_BUFFER_ROW(lY) + LCD_ROW_OFFSET(lX1)); // word aligned
+    for (; lX1 < lX2; lX1 += LCD_PIXELS_PER_WORD) {
+        *pWrite++ = ulFill;
+    }
+}
+
+
+//*****************************************************************************
+//
+// Returns palette index ui32Pixel of 4 or 8 bpp image data, the left pixel of
+// a 4 bpp byte being in the upper nibble.
+//
+//*****************************************************************************
+static inline uint32_t Crystalfontz128x128_ImageIndex(const uint8_t *pucData, int32_t lBPP,
+                                                      uint32_t ui32Pixel)
+{
+    if (lBPP == 4) return (pucData[ui32Pixel >> 1] >> ((ui32Pixel & 1) ? 0 : 4)) & 15;
+    return pucData[ui32Pixel];
+}
+
+
+//*****************************************************************************
+//
+// Returns image palette entry ui32Index as a frame buffer value, translating
+// it with ColorTranslate only the first time it is used.
+//
+//*****************************************************************************
+static inline uint32_t Crystalfontz128x128_ImageColor(void *pvDisplayData,
+                                                      const uint8_t *pucPalette,
+                                                      uint32_t ui32Index)
+{
+    if (!(Lcd_imagePaletteValid[ui32Index >> 5] & (1u << (ui32Index & 31))))
+    {
+        Lcd_imagePaletteNative[ui32Index] =
+            Crystalfontz128x128_ColorTranslate(pvDisplayData, *(uint32_t *)(pucPalette + 3 * ui32Index));
+        Lcd_imagePaletteValid[ui32Index >> 5] |= 1u << (ui32Index & 31);
+    }
+    return Lcd_imagePaletteNative[ui32Index];
+}
+
+
+//*****************************************************************************
+//
+//! Discards the translated image palette entries.
+//!
+//! PixelDrawMultiple translates the 24-bit palette of a 4 or 8 bpp image
+//! once and keeps the result until it is passed a palette at a different
+//! address. Call this after changing a palette in RAM in place.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_InvalidatePaletteCache(void)
+{
+    Lcd_imagePalette = 0;
+}
+
+
 //*****************************************************************************
 //
 //! Draws a pixel on the screen.
@@ -209,7 +505,8 @@ void Crystalfontz128x128_SetOrientation(uint8_t orientation)
 static void Crystalfontz128x128_PixelDraw(void *pvDisplayData, int32_t lX, int32_t lY,
                                    uint32_t ulValue)
 {
-    Lcd_buffer[lY][lX] = ulValue;
+    Crystalfontz128x128_MarkDirty(lX, lX, lY, lY);
+    Crystalfontz128x128_PutPixel(lX, lY, ulValue);
 }
 
 
@@ -244,8 +541,16 @@ static void Crystalfontz128x128_PixelDrawMultiple(void *pvDisplayData, int32_t l
                                            const uint8_t *pucData,
                                            const uint8_t *pucPalette)
 {
-    uint32_t Data, rgb, native;
-    uint16_t *pWrite = &Lcd_buffer[lY][lX]; // pointer to the write location in Lcd_buffer[]
+    uint32_t Data;
+#if LCD_BPP == 4
+#define LCD_WRITE_NEXT(v) Crystalfontz128x128_PutPixel(lX++, lY, (v))
+#else
+    LCD_BUFFER_TYPE *pWrite = &LCD_BUFFER_ROW(lY)[lX]; // pointer to the write location in Lcd_buffer[]
+#define LCD_WRITE_NEXT(v) (*pWrite++ = (v))
+#endif
+
+    if (lCount <= 0) return;
+    Crystalfontz128x128_MarkDirty(lX, lX + lCount - 1, lY, lY);
 
     //
     // Determine how to interpret the pixel data based on the number of bits
@@ -266,7 +571,7 @@ static void Crystalfontz128x128_PixelDrawMultiple(void *pvDisplayData, int32_t l
                 for(; (lX0 < 8) && lCount; lX0++, lCount--)
                 {
                     // Draw this pixel in the appropriate color
-                    *pWrite++ = ((uint32_t *)pucPalette)[(Data >> (7 - lX0)) & 1];
+                    LCD_WRITE_NEXT(((uint32_t *)pucPalette)[(Data >> (7 - lX0)) & 1]);
                 }
 
                 // Start at the beginning of the next byte of image data
@@ -277,70 +582,53 @@ static void Crystalfontz128x128_PixelDrawMultiple(void *pvDisplayData, int32_t l
             break;
         }
 
-        // The pixel data is in 4 bit per pixel format
+        // The pixel data is in 4 or 8 bit per pixel format
         case 4:
+        case 8:
         {
-            // Loop while there are more pixels to draw.  "Duff's device" is
-            // used to jump into the middle of the loop if the first nibble of
-            // the pixel data should not be used.  Duff's device makes use of
-            // the fact that a case statement is legal anywhere within a
-            // sub-block of a switch statement.  See
-            // http://en.wikipedia.org/wiki/Duff's_device for detailed
-            // information about Duff's device.
-            switch(lX0 & 1)
+            uint32_t ui32Pixel = (lBPP == 4) ? (lX0 & 1) : 0; // next pixel in pucData
+
+            // Start over if this is not the palette translated last time
+            if (pucPalette != Lcd_imagePalette)
             {
-                case 0:
-
-                    while(lCount)
-                    {
-                        // Get the upper nibble of the next byte of pixel data
-                        // and extract the corresponding entry from the palette
-                        Data = (*pucData >> 4);
-                        rgb = *(uint32_t *)(pucPalette + 3*Data);
-                        native = Crystalfontz128x128_ColorTranslate(pvDisplayData, rgb);
-                        // Write to LCD screen
-                        *pWrite++ = native;
-
-                        // Decrement the count of pixels to draw
-                        lCount--;
-
-                        // See if there is another pixel to draw
-                        if(lCount)
-                        {
-                case 1:
-                            // Get the lower nibble of the next byte of pixel
-                            // data and extract the corresponding entry from
-                            // the palette
-                            Data = (*pucData++ & 15);
-                            rgb = *(uint32_t *)(pucPalette + 3*Data);
-                            native = Crystalfontz128x128_ColorTranslate(pvDisplayData, rgb);
-                            // Write to LCD screen
-                            *pWrite++ = native;
-
-                            // Decrement the count of pixels to draw
-                            lCount--;
-                        }
-                    }
+                memset(Lcd_imagePaletteValid, 0, sizeof(Lcd_imagePaletteValid));
+                Lcd_imagePalette = pucPalette;
             }
-            // The image data has been drawn.
 
-            break;
-        }
+#if LCD_BPP == 4
+            while(lCount--)
+            {
+                Data = Crystalfontz128x128_ImageIndex(pucData, lBPP, ui32Pixel++);
+                LCD_WRITE_NEXT(Crystalfontz128x128_ImageColor(pvDisplayData, pucPalette, Data));
+            }
+#else
+            // Single pixels up to a word boundary in the frame buffer
+            for(; ((uintptr_t)pWrite & 3) && lCount; lCount--)
+            {
+                Data = Crystalfontz128x128_ImageIndex(pucData, lBPP, ui32Pixel++);
+                LCD_WRITE_NEXT(Crystalfontz128x128_ImageColor(pvDisplayData, pucPalette, Data));
+            }
 
-        // The pixel data is in 8 bit per pixel format
-        case 8:
-        {
-            // Loop while there are more pixels to draw
+            // Whole words, the leftmost pixel in the low bits
+            for(; lCount >= LCD_PIXELS_PER_WORD; lCount -= LCD_PIXELS_PER_WORD)
+            {
+                uint32_t ui32Word = 0, i;
+                for(i = 0; i < LCD_PIXELS_PER_WORD; i++)
+                {
+                    Data = Crystalfontz128x128_ImageIndex(pucData, lBPP, ui32Pixel++);
+                    ui32Word |= Crystalfontz128x128_ImageColor(pvDisplayData, pucPalette, Data) << (i * LCD_BPP);
+                }
+                *(uint32_t *)pWrite = ui32Word;
+                pWrite += LCD_PIXELS_PER_WORD;
+            }
+
+            // The rest of the pixels
             while(lCount--)
             {
-                // Get the next byte of pixel data and extract the
-                // corresponding entry from the palette
-                Data = *pucData++;
-                rgb = *(uint32_t *)(pucPalette + 3*Data);
-                native = Crystalfontz128x128_ColorTranslate(pvDisplayData, rgb);
-                // Write to LCD screen
-                *pWrite++ = native;
+                Data = Crystalfontz128x128_ImageIndex(pucData, lBPP, ui32Pixel++);
+                LCD_WRITE_NEXT(Crystalfontz128x128_ImageColor(pvDisplayData, pucPalette, Data));
             }
+#endif
             // The image data has been drawn
             break;
         }
@@ -351,24 +639,15 @@ static void Crystalfontz128x128_PixelDrawMultiple(void *pvDisplayData, int32_t l
         // not used by the graphics library but which is helpful to
         // applications which may want to handle, for example, JPEG images.
         //
+#if LCD_BPP == 16
         case 16:
         {
-            uint16_t usData;
-
-            // Loop while there are more pixels to draw.
-
-            while(lCount--)
-            {
-                // Get the next byte of pixel data and extract the
-                // corresponding entry from the palette
-                usData = *((uint16_t *)pucData);
-                pucData += 2;
-
-                // Translate this palette entry and write it to the screen
-                *pWrite++ = usData;
-            }
+            memcpy(pWrite, pucData, lCount * sizeof(uint16_t));
+            break;
         }
+#endif
     }
+#undef LCD_WRITE_NEXT
 }
 
 
@@ -392,22 +671,8 @@ static void Crystalfontz128x128_PixelDrawMultiple(void *pvDisplayData, int32_t l
 static void Crystalfontz128x128_LineDrawH(void *pvDisplayData, int32_t lX1, int32_t lX2,
                                    int32_t lY, uint32_t ulValue)
 {
-    if (lX1 & 1) { // starts at an odd coordinate: fill in first pixel
-        Lcd_buffer[lY][lX1] = ulValue;
-        lX1++;
-    }
-
-    if (!(lX2 & 1)) { // ends at an even coordinate: fill in last pixel
-        Lcd_buffer[lY][lX2] = ulValue;
-        lX2--;
-    }
-
-    // fill in the bulk of the line 2 pixels at a time
-    uint32_t *pWrite = (uint32_t*)&Lcd_buffer[lY][lX1]; // pointer to the start of the line
-    uint32_t fill = ulValue | (ulValue << 16);
-    for (; lX1 < lX2; lX1 += 2) {
-        *pWrite++ = fill;
-    }
+    Crystalfontz128x128_MarkDirty(lX1, lX2, lY, lY);
+    Crystalfontz128x128_FillSpan(lX1, lX2, lY, LCD_FILL_WORD(ulValue));
 }
 
 
@@ -431,9 +696,11 @@ static void Crystalfontz128x128_LineDrawH(void *pvDisplayData, int32_t lX1, int3
 static void Crystalfontz128x128_LineDrawV(void *pvDisplayData, int32_t lX, int32_t lY1,
                                    int32_t lY2, uint32_t ulValue)
 {
+    Crystalfontz128x128_MarkDirty(lX, lX, lY1, lY2);
+
     // fill the line
     for (; lY1 <= lY2; lY1++) {
-        Lcd_buffer[lY1][lX] = ulValue;
+        Crystalfontz128x128_PutPixel(lX, lY1, ulValue);
     }
 }
 
@@ -462,32 +729,108 @@ static void Crystalfontz128x128_RectFill(void *pvDisplayData, const tRectangle *
     int32_t lX2 = pRect->i16XMax;
     int32_t lY1 = pRect->i16YMin;
     int32_t lY2 = pRect->i16YMax;
-    uint32_t i;
-    if (lX1 & 1) { // starts at an odd coordinate: fill in first column
-        for (i = lY1; i <= lY2; i++) {
-            Lcd_buffer[i][lX1] = ulValue;
-        }
-        lX1++;
+    uint32_t fill = LCD_FILL_WORD(ulValue);
+
+    Crystalfontz128x128_MarkDirty(lX1, lX2, lY1, lY2);
+
+    for (; lY1 <= lY2; lY1++) {
+        Crystalfontz128x128_FillSpan(lX1, lX2, lY1, fill);
     }
+}
 
-    if (!(lX2 & 1)) { // ends at an even coordinate: fill in last column
-        for (i = lY1; i <= lY2; i++) {
-            Lcd_buffer[i][lX2] = ulValue;
-        }
-        lX2--;
+#if LCD_BPP != 16
+//*****************************************************************************
+//
+// Converts between RGB565 and the pixel format sent to the panel, which is
+// what Lcd_palette[] holds.
+//
+//*****************************************************************************
+static inline uint16_t Crystalfontz128x128_PalettePixel(uint32_t rgb565)
+{
+#if LCD_SSI_PIXEL_16BIT
+    return rgb565;
+#else
+    return (rgb565 >> 8) | ((rgb565 << 8) & 0xff00);
+#endif
+}
+
+static inline uint32_t Crystalfontz128x128_PaletteRGB565(uint32_t ui32Index)
+{
+    return Crystalfontz128x128_PalettePixel(Lcd_palette[ui32Index]); // the swap is its own inverse
+}
+
+
+//*****************************************************************************
+//
+// Returns the palette index for an RGB565 color: an exact match if there is
+// one, otherwise a newly allocated entry while the palette has room, and the
+// nearest entry (squared distance, components scaled to 6 bits) after that.
+//
+//*****************************************************************************
+static uint32_t Crystalfontz128x128_PaletteIndex(uint32_t rgb565)
+{
+    uint32_t i, entry, best = 0, bestDist = 0xffffffff, dist;
+    int32_t dr, dg, db;
+
+    for (i = 0; i < Lcd_paletteCount; i++) {
+        if (Crystalfontz128x128_PaletteRGB565(i) == rgb565) return i;
     }
 
-    // fill the bulk of the rectangle
-    uint32_t fill = ulValue | (ulValue << 16);
-    for (; lY1 <= lY2; lY1++) {
-        // fill 2 pixels at a time
-        uint32_t *pWrite = (uint32_t*)&Lcd_buffer[lY1][lX1]; // pointer to the start of the line
-        for (i = lX1; i < lX2; i += 2) {
-            *pWrite++ = fill;
+    if (Lcd_paletteCount < LCD_PALETTE_SIZE) {
+        Lcd_palette[Lcd_paletteCount] = Crystalfontz128x128_PalettePixel(rgb565);
+        return Lcd_paletteCount++;
+    }
+
+    for (i = 0; i < LCD_PALETTE_SIZE; i++) {
+        entry = Crystalfontz128x128_PaletteRGB565(i);
+        dr = (int32_t)((entry >> 11) - (rgb565 >> 11)) * 2;
+        dg = (int32_t)((entry >> 5) & 0x3f) - (int32_t)((rgb565 >> 5) & 0x3f);
+        db = (int32_t)((entry & 0x1f) - (rgb565 & 0x1f)) * 2;
+        dist = dr * dr + dg * dg + db * db;
+        if (dist < bestDist) {
+            bestDist = dist;
+            best = i;
         }
     }
+    return best;
 }
 
+
+//*****************************************************************************
+//
+//! Loads the palette used by the indexed frame buffer formats.
+//!
+//! \param pui32Colors is an array of 24-bit RGB colors (ClrXxx values).
+//! \param ui32Count is the number of colors, at most LCD_PALETTE_SIZE.
+//!
+//! Index i of the frame buffer shows pui32Colors[i]. The remaining entries
+//! are free for ColorTranslate to allocate. Colors translated before this
+//! call (e.g. a context's foreground) must be set again, and the whole screen
+//! is sent by the next flush.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SetPalette(const uint32_t *pui32Colors, uint32_t ui32Count)
+{
+    uint32_t i, ulValue;
+
+    if (ui32Count > LCD_PALETTE_SIZE) ui32Count = LCD_PALETTE_SIZE;
+    while (Lcd_flushBusy); // the transfer expands indices through the palette
+    for (i = 0; i < ui32Count; i++) {
+        ulValue = pui32Colors[i];
+        Lcd_palette[i] = Crystalfontz128x128_PalettePixel(((ulValue & 0x00f80000) >> 8) |
+                                                          ((ulValue & 0x0000fc00) >> 5) |
+                                                          ((ulValue & 0x000000f8) >> 3));
+    }
+    if (ui32Count == 0) Lcd_palette[ui32Count++] = 0; // keep index 0 black
+    Lcd_paletteCount = ui32Count;
+    Lcd_imagePalette = 0; // image colors map to different indices now
+    Crystalfontz128x128_Invalidate();
+}
+#endif
+
+
 //*****************************************************************************
 //
 //! Translates a 24-bit RGB color to a display driver-specific color.
@@ -515,7 +858,13 @@ static uint32_t Crystalfontz128x128_ColorTranslate(void *pvDisplayData,
            ((((ulValue) & 0x00f80000) >> 8) |
             (((ulValue) & 0x0000fc00) >> 5) |
             (((ulValue) & 0x000000f8) >> 3));
+#if LCD_BPP != 16
+    return Crystalfontz128x128_PaletteIndex(rgb565);
+#elif LCD_SSI_PIXEL_16BIT
+    return rgb565; // sent as one 16-bit frame, MSB first
+#else
     return (rgb565 >> 8) | ((rgb565 << 8) & 0xff00);  // swap bytes
+#endif
 }
 
 
@@ -532,24 +881,273 @@ static uint32_t Crystalfontz128x128_ColorTranslate(void *pvDisplayData,
 //!
 //! Gene Bogdanov: Added local frame buffer.
 //!
+//! Only the dirty part of the frame buffer is sent. Consecutive dirty rows
+//! whose spans overlap are merged into one rectangle, and each rectangle is
+//! written through its own draw frame window. In \b LCD_FLUSH_ASYNC mode the
+//! rectangles are queued for the SSI TX interrupt and the function returns
+//! right away (after any previous asynchronous flush has finished).
+//!
 //! \return None.
 //
 //*****************************************************************************
+static void Crystalfontz128x128_FlushDone(void)
+{
+    Lcd_flushBusy = false;
+    if (Lcd_pfnFlushDone) Lcd_pfnFlushDone();
+}
+
+//*****************************************************************************
+//
+// Sends the rectangles in Lcd_windows[] from pFrame, whose first row is
+// screen row lFrameY0, in the current flush mode.
+//
+//*****************************************************************************
+static void Crystalfontz128x128_SendWindows(LCD_BUFFER_TYPE (*pFrame)[LCD_BUFFER_WIDTH],
+                                            int32_t lFrameY0)
+{
+    int32_t y;
+    uint32_t i;
+    tLcdWindow *psWindow;
+    tLcdTransfer *psTransfer;
+
+    if (Lcd_flushMode == LCD_FLUSH_ASYNC)
+    {
+        if (Lcd_windowCount == 0)
+        {
+            if (Lcd_pfnFlushDone) Lcd_pfnFlushDone();
+            return;
+        }
+        psTransfer = Lcd_transfers;
+        for (i = 0; i < Lcd_windowCount; i++)
+        {
+            psWindow = &Lcd_windows[i];
+            Crystalfontz128x128_FrameParams(psWindow->x0, psWindow->y0, psWindow->x1, psWindow->y1,
+                                            psWindow->pui8Caset, psWindow->pui8Raset);
+            psTransfer->ui8Command = CM_CASET;
+            psTransfer->pui8Data = psWindow->pui8Caset;
+            psTransfer->ui16RowBytes = psTransfer->ui16RowStride = 4;
+            psTransfer->ui16Rows = 1;
+            psTransfer->bPixels = false;
+            psTransfer->pui16Palette = 0;
+            psTransfer++;
+            psTransfer->ui8Command = CM_RASET;
+            psTransfer->pui8Data = psWindow->pui8Raset;
+            psTransfer->ui16RowBytes = psTransfer->ui16RowStride = 4;
+            psTransfer->ui16Rows = 1;
+            psTransfer->bPixels = false;
+            psTransfer->pui16Palette = 0;
+            psTransfer++;
+            psTransfer->ui8Command = CM_RAMWR;
+            psTransfer->pui8Data = (const uint8_t *)pFrame[psWindow->y0 - lFrameY0] + LCD_ROW_OFFSET(psWindow->x0);
+            psTransfer->ui16RowBytes = LCD_ROW_OFFSET(psWindow->x1 - psWindow->x0 + 1);
+            psTransfer->ui16RowStride = sizeof(pFrame[0]);
+            psTransfer->ui16Rows = psWindow->y1 - psWindow->y0 + 1;
+            psTransfer->bPixels = true;
+#if LCD_BPP != 16
+            psTransfer->pui16Palette = Lcd_palette;
+            psTransfer->ui8IndexBits = LCD_BPP;
+#else
+            psTransfer->pui16Palette = 0;
+#endif
+            psTransfer++;
+        }
+        Lcd_flushBusy = true;
+        HAL_LCD_startTransfer(Lcd_transfers, psTransfer - Lcd_transfers, Crystalfontz128x128_FlushDone);
+        return;
+    }
+
+    for (i = 0; i < Lcd_windowCount; i++)
+    {
+        psWindow = &Lcd_windows[i];
+        Crystalfontz128x128_SetDrawFrame(psWindow->x0, psWindow->y0, psWindow->x1, psWindow->y1);
+        HAL_LCD_writeCommand(CM_RAMWR);
+        for (y = psWindow->y0; y <= psWindow->y1; y++)
+        {
+#if LCD_BPP != 16
+            HAL_LCD_writeIndexedBurst((const uint8_t *)pFrame[y - lFrameY0] + LCD_ROW_OFFSET(psWindow->x0),
+                                      psWindow->x1 - psWindow->x0 + 1, LCD_BPP, Lcd_palette);
+#else
+            HAL_LCD_writePixelBurst(&pFrame[y - lFrameY0][psWindow->x0], psWindow->x1 - psWindow->x0 + 1);
+#endif
+        }
+    }
+}
+
 static void
 Crystalfontz128x128_Flush(void *pvDisplayData)
 {
-    Crystalfontz128x128_SetDrawFrame(0, 0, LCD_HORIZONTAL_MAX-1, LCD_VERTICAL_MAX-1);
-    HAL_LCD_writeCommand(CM_RAMWR);
-    int i;
-    uint16_t *pRead = &Lcd_buffer[0][0];
-    uint32_t data;
-    for (i = 0; i < LCD_HORIZONTAL_MAX * LCD_VERTICAL_MAX; i++)
+    int32_t x0, x1, y, y0;
+#if LCD_DOUBLE_BUFFER
+    uint32_t i;
+#endif
+    tLcdWindow *psWindow;
+    LCD_BUFFER_TYPE (*pFrame)[LCD_BUFFER_WIDTH] = Lcd_buffer; // frame to send
+
+#if LCD_BAND_ROWS
+    return; // the bands are sent by Crystalfontz128x128_RenderBands()
+#endif
+
+    while (Lcd_flushBusy); // one asynchronous flush in flight at a time
+
+    // collect the dirty rectangles and mark the frame buffer clean
+    Lcd_windowCount = 0;
+    for (y = 0; y < LCD_VERTICAL_MAX; y++)
+    {
+        if (Lcd_dirtyXMin[y] > Lcd_dirtyXMax[y]) continue; // clean row
+
+        // grow the rectangle down while the next row's span overlaps it
+        x0 = Lcd_dirtyXMin[y];
+        x1 = Lcd_dirtyXMax[y];
+        y0 = y;
+        while (y + 1 < LCD_VERTICAL_MAX &&
+               Lcd_dirtyXMin[y + 1] <= x1 && Lcd_dirtyXMax[y + 1] >= x0)
+        {
+            y++;
+            if (Lcd_dirtyXMin[y] < x0) x0 = Lcd_dirtyXMin[y];
+            if (Lcd_dirtyXMax[y] > x1) x1 = Lcd_dirtyXMax[y];
+        }
+        if (Lcd_windowCount < LCD_MAX_WINDOWS)
+        {
+            psWindow = &Lcd_windows[Lcd_windowCount++];
+            psWindow->x0 = x0;
+            psWindow->y0 = y0;
+        }
+        else
+        {
+            // out of windows: extend the last one down over this rectangle
+            psWindow = &Lcd_windows[LCD_MAX_WINDOWS - 1];
+            if (x0 < psWindow->x0) psWindow->x0 = x0;
+            if (x1 < psWindow->x1) x1 = psWindow->x1;
+        }
+        psWindow->x1 = x1;
+        psWindow->y1 = y;
+
+        for (; y0 <= y; y0++)
+        {
+            Lcd_dirtyXMin[y0] = 0xff; // mark clean
+            Lcd_dirtyXMax[y0] = 0;
+        }
+    }
+
+#if LCD_DOUBLE_BUFFER
+    if (Lcd_windowCount)
     {
-        data = *pRead++;
-        HAL_LCD_writeData((uint8_t)data);
-        HAL_LCD_writeData((uint8_t)(data >> 8));
+        // the finished frame becomes the front buffer. The old front buffer
+        // holds the previous frame, which differs from this one only inside
+        // the dirty rectangles: copy those over so drawing can continue.
+        pFrame = Lcd_buffer;
+        Lcd_buffer = Lcd_front;
+        Lcd_front = pFrame;
+        for (i = 0; i < Lcd_windowCount; i++)
+        {
+            psWindow = &Lcd_windows[i];
+            for (y = psWindow->y0; y <= psWindow->y1; y++)
+            {
+                memcpy((uint8_t *)Lcd_buffer[y] + LCD_ROW_OFFSET(psWindow->x0),
+                       (uint8_t *)pFrame[y] + LCD_ROW_OFFSET(psWindow->x0),
+                       LCD_ROW_OFFSET(psWindow->x1 - psWindow->x0 + 1));
+            }
+        }
     }
+#endif
+
+    Crystalfontz128x128_SendWindows(pFrame, 0);
+}
+
+
+#if LCD_BAND_ROWS
+//*****************************************************************************
+//
+//! Sets the strip height used by Crystalfontz128x128_RenderBands().
+//!
+//! \param ui32Rows is the number of rows per strip, limited to 1 through
+//! LCD_BAND_ROWS.
+//!
+//! Smaller strips replay the draw callback more often; the strip buffer is
+//! always LCD_BAND_ROWS rows.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_SetBandRows(uint32_t ui32Rows)
+{
+    if (ui32Rows < 1) ui32Rows = 1;
+    if (ui32Rows > LCD_BAND_ROWS) ui32Rows = LCD_BAND_ROWS;
+    Lcd_bandRows = ui32Rows;
+}
+
+
+//*****************************************************************************
+//
+//! Renders the screen one strip at a time.
+//!
+//! \param psContext is the grlib context pfnDraw draws with, or NULL.
+//! \param pfnDraw draws the whole screen with psContext, or NULL to clear
+//! the screen.
+//!
+//! For every strip of rows the strip buffer is cleared to black, the clip
+//! region of psContext is narrowed to the strip and pfnDraw is called, then
+//! the strip is sent to its own draw frame in the current flush mode. pfnDraw
+//! therefore runs once per strip and must draw the same picture every time;
+//! grlib drops everything outside the strip. The clip region is restored on
+//! return.
+//!
+//! In asynchronous mode a strip is sent while the next one is drawn if
+//! LCD_DOUBLE_BUFFER is set, otherwise drawing waits for the previous strip.
+//! The last strip may still be in progress on return.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void Crystalfontz128x128_RenderBands(tContext *psContext, void (*pfnDraw)(tContext *psContext))
+{
+    int32_t y0, y1;
+    tRectangle sClip, sBand;
+    LCD_BUFFER_TYPE (*pFrame)[LCD_BUFFER_WIDTH];
+
+    if (psContext) sClip = psContext->sClipRegion;
+
+    for (y0 = 0; y0 < LCD_VERTICAL_MAX; y0 = y1 + 1)
+    {
+        y1 = y0 + Lcd_bandRows - 1;
+        if (y1 > LCD_VERTICAL_MAX - 1) y1 = LCD_VERTICAL_MAX - 1;
+
+#if !LCD_DOUBLE_BUFFER
+        while (Lcd_flushBusy); // the strip buffer is still being sent
+#endif
+        Lcd_bandY0 = y0;
+        memset(Lcd_buffer, 0, sizeof(Lcd_buffer[0]) * (y1 - y0 + 1));
+
+        if (psContext && pfnDraw)
+        {
+            sBand = sClip;
+            if (sBand.i16YMin < y0) sBand.i16YMin = y0;
+            if (sBand.i16YMax > y1) sBand.i16YMax = y1;
+            if (sBand.i16YMin <= sBand.i16YMax)
+            {
+                GrContextClipRegionSet(psContext, &sBand);
+                pfnDraw(psContext);
+            }
+        }
+
+        while (Lcd_flushBusy); // Lcd_windows[] is in use until the last strip is sent
+        Lcd_windows[0].x0 = 0;
+        Lcd_windows[0].y0 = y0;
+        Lcd_windows[0].x1 = LCD_HORIZONTAL_MAX - 1;
+        Lcd_windows[0].y1 = y1;
+        Lcd_windowCount = 1;
+
+        pFrame = Lcd_buffer;
+#if LCD_DOUBLE_BUFFER
+        Lcd_buffer = Lcd_front; // draw the next strip while this one is sent
+        Lcd_front = pFrame;
+#endif
+        Crystalfontz128x128_SendWindows(pFrame, y0);
+    }
+
+    if (psContext) GrContextClipRegionSet(psContext, &sClip);
 }
+#endif
 
 
 //*****************************************************************************
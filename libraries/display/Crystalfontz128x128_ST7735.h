@@ -55,6 +55,55 @@
 #define LCD_ORIENTATION_DOWN  2
 #define LCD_ORIENTATION_RIGHT 3
 
+#define LCD_FLUSH_BLOCKING    0
+#define LCD_FLUSH_ASYNC       1
+
+// Frame buffering:
+// 0 = one frame buffer (32 KB), drawing waits for rows an asynchronous flush
+//     has not sent yet,
+// 1 = two frame buffers (64 KB), grlib draws into the back buffer while the
+//     front buffer is sent; each flush swaps them
+#ifndef LCD_DOUBLE_BUFFER
+#define LCD_DOUBLE_BUFFER     0
+#endif
+
+// Frame buffer pixel format:
+// 16 = RGB565 (32 KB per frame buffer),
+//  8 = 8-bit indices into a 256-entry palette (16 KB),
+//  4 = 4-bit indices into a 16-entry palette (8 KB), two pixels per byte
+//      with the left one in the upper nibble.
+// In the indexed formats ColorTranslate returns palette indices, allocating
+// entries for new colors until the palette is full and picking the nearest
+// entry after that; the flush expands the indices to RGB565.
+#ifndef LCD_BPP
+#define LCD_BPP               16
+#endif
+
+// Banded rendering:
+// 0 = the frame buffer holds the whole screen,
+// N = the frame buffer is a strip of N rows (N * 256 bytes at 16 bpp).
+//     Crystalfontz128x128_RenderBands() replays a draw callback once per
+//     strip with the clip region set to it and sends each strip as it is
+//     finished; grlib's flush does nothing in this mode.
+#ifndef LCD_BAND_ROWS
+#define LCD_BAND_ROWS         0
+#endif
+
+#if LCD_BAND_ROWS
+#define LCD_BUFFER_ROWS       LCD_BAND_ROWS
+#else
+#define LCD_BUFFER_ROWS       LCD_VERTICAL_MAX
+#endif
+
+#if LCD_BPP == 16
+#define LCD_BUFFER_TYPE       uint16_t
+#define LCD_BUFFER_WIDTH      LCD_HORIZONTAL_MAX
+#else
+#define LCD_BUFFER_TYPE       uint8_t
+#define LCD_BUFFER_WIDTH      (LCD_HORIZONTAL_MAX * LCD_BPP / 8)
+#define LCD_PALETTE_SIZE      (1 << LCD_BPP)
+#endif
+
 // ST7735 LCD controller Command Set
 #define CM_NOP             0x00
 #define CM_SWRESET         0x01
@@ -99,7 +148,14 @@ extern uint16_t Lcd_ScreenWidth, Lcd_ScreenHeigth;
 extern uint8_t Lcd_PenSolid, Lcd_FontSolid, Lcd_FlagRead;
 extern uint16_t Lcd_TouchTrim;
 
-extern uint16_t Lcd_buffer[LCD_VERTICAL_MAX][LCD_HORIZONTAL_MAX];
+#if LCD_DOUBLE_BUFFER
+extern LCD_BUFFER_TYPE (*Lcd_buffer)[LCD_BUFFER_WIDTH]; // back buffer, changes on every flush
+#else
+extern LCD_BUFFER_TYPE Lcd_buffer[LCD_BUFFER_ROWS][LCD_BUFFER_WIDTH];
+#endif
+#if LCD_BPP != 16
+extern uint16_t Lcd_palette[LCD_PALETTE_SIZE]; // pixels sent for each index
+#endif
 
 extern const tDisplay g_sCrystalfontz128x128;
 
@@ -109,6 +165,24 @@ extern void Crystalfontz128x128_SetDrawFrame(uint32_t x0, uint32_t y0, uint32_t
 
 extern void Crystalfontz128x128_SetOrientation(uint8_t orientation);
 
+extern void Crystalfontz128x128_Invalidate(void);
+
+extern void Crystalfontz128x128_SetFlushMode(uint8_t mode, void (*pfnDone)(void));
+
+extern bool Crystalfontz128x128_IsFlushBusy(void);
+
+extern void Crystalfontz128x128_InvalidatePaletteCache(void);
+
+#if LCD_BAND_ROWS
+extern void Crystalfontz128x128_SetBandRows(uint32_t ui32Rows);
+
+extern void Crystalfontz128x128_RenderBands(tContext *psContext, void (*pfnDraw)(tContext *psContext));
+#endif
+
+#if LCD_BPP != 16
+extern void Crystalfontz128x128_SetPalette(const uint32_t *pui32Colors, uint32_t ui32Count);
+#endif
+
 
 
 #endif /* __CRYSTALFONTZLCD_H__ */
@@ -0,0 +1,320 @@
+//*****************************************************************************
+//
+// GlyphCache.c - Cache of pre-rendered grlib glyphs.
+//
+// A glyph is rendered once by grlib into a small capture display, in the
+// font and translated colors of the context, and kept as runs of native
+// pixels. Drawing it again copies the runs into the frame buffer through
+// the display's 16 bpp PixelDrawMultiple path instead of decoding the font.
+//
+//*****************************************************************************
+
+#include "GlyphCache.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "grlib/grlib.h"
+#include "Crystalfontz128x128_ST7735.h"
+
+#if LCD_BPP == 16
+
+// One horizontal run of pixels written by the glyph
+typedef struct
+{
+    uint8_t ui8Y, ui8X, ui8Count;
+} tGlyphRun;
+
+typedef struct
+{
+    const tFont *psFont;        // key: font, character and colors
+    uint32_t ui32Foreground;
+    uint32_t ui32Background;
+    uint8_t ui8Char;
+    bool bOpaque;
+    uint8_t ui8Width, ui8Height;
+    uint8_t ui8Runs;
+    uint32_t ui32LastUse;       // 0 marks a free slot
+    tGlyphRun psRuns[GLYPH_CACHE_SLOT_RUNS];
+    uint16_t pui16Pixels[GLYPH_CACHE_SLOT_PIXELS]; // row by row, ui8Width wide
+} tGlyphSlot;
+
+static tGlyphSlot g_psGlyphSlots[GLYPH_CACHE_SLOTS];
+static uint32_t g_ui32GlyphUse;
+
+//*****************************************************************************
+//
+// Capture display: grlib renders a missing glyph into the slot pixels and
+// g_pui8CaptureMask[] records which of them it wrote.
+//
+//*****************************************************************************
+static tGlyphSlot *g_psCaptureSlot;
+static uint8_t g_pui8CaptureMask[GLYPH_CACHE_SLOT_PIXELS];
+static bool g_bCaptureFailed;
+
+static void GlyphCache_CaptureSpan(int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value)
+{
+    uint32_t i = i32Y * g_psCaptureSlot->ui8Width;
+    for (; i32X1 <= i32X2; i32X1++) {
+        g_psCaptureSlot->pui16Pixels[i + i32X1] = ui32Value;
+        g_pui8CaptureMask[i + i32X1] = 1;
+    }
+}
+
+static void GlyphCache_CapturePixelDraw(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                                        uint32_t ui32Value)
+{
+    GlyphCache_CaptureSpan(i32X, i32X, i32Y, ui32Value);
+}
+
+static void GlyphCache_CapturePixelDrawMultiple(void *pvDisplayData, int32_t i32X, int32_t i32Y,
+                                                int32_t i32X0, int32_t i32Count, int32_t i32BPP,
+                                                const uint8_t *pui8Data,
+                                                const uint8_t *pui8Palette)
+{
+    for (; i32Count > 0; i32Count--, i32X++) {
+        if (i32BPP == 1) {
+            GlyphCache_CaptureSpan(i32X, i32X, i32Y,
+                                   ((const uint32_t *)pui8Palette)[(*pui8Data >> (7 - i32X0)) & 1]);
+            if (++i32X0 == 8) {
+                i32X0 = 0;
+                pui8Data++;
+            }
+        } else {
+            g_bCaptureFailed = true; // anti-aliased fonts are left to grlib
+            return;
+        }
+    }
+}
+
+static void GlyphCache_CaptureLineDrawH(void *pvDisplayData, int32_t i32X1, int32_t i32X2,
+                                        int32_t i32Y, uint32_t ui32Value)
+{
+    GlyphCache_CaptureSpan(i32X1, i32X2, i32Y, ui32Value);
+}
+
+static void GlyphCache_CaptureLineDrawV(void *pvDisplayData, int32_t i32X, int32_t i32Y1,
+                                        int32_t i32Y2, uint32_t ui32Value)
+{
+    for (; i32Y1 <= i32Y2; i32Y1++) {
+        GlyphCache_CaptureSpan(i32X, i32X, i32Y1, ui32Value);
+    }
+}
+
+static void GlyphCache_CaptureRectFill(void *pvDisplayData, const tRectangle *psRect,
+                                       uint32_t ui32Value)
+{
+    int32_t i32Y;
+    for (i32Y = psRect->i16YMin; i32Y <= psRect->i16YMax; i32Y++) {
+        GlyphCache_CaptureSpan(psRect->i16XMin, psRect->i16XMax, i32Y, ui32Value);
+    }
+}
+
+static uint32_t GlyphCache_CaptureColorTranslate(void *pvDisplayData, uint32_t ui32Value)
+{
+    return DpyColorTranslate(&g_sCrystalfontz128x128, ui32Value);
+}
+
+static void GlyphCache_CaptureFlush(void *pvDisplayData)
+{
+}
+
+static tDisplay g_sGlyphCapture =
+{
+    sizeof(tDisplay),
+    0,
+    0, // set to the glyph size before rendering
+    0,
+    GlyphCache_CapturePixelDraw,
+    GlyphCache_CapturePixelDrawMultiple,
+    GlyphCache_CaptureLineDrawH,
+    GlyphCache_CaptureLineDrawV,
+    GlyphCache_CaptureRectFill,
+    GlyphCache_CaptureColorTranslate,
+    GlyphCache_CaptureFlush
+};
+
+//*****************************************************************************
+//
+// Returns the cached glyph of ui8Char in the font and colors of psContext,
+// rendering it into the least recently used slot if needed, or NULL if the
+// glyph cannot be cached.
+//
+//*****************************************************************************
+static tGlyphSlot *GlyphCache_Lookup(const tContext *psContext, uint8_t ui8Char, bool bOpaque)
+{
+    uint32_t i, ui32Width, ui32Height, ui32Row;
+    uint32_t ui32Background = bOpaque ? psContext->ui32Background : 0;
+    tGlyphSlot *psSlot, *psOldest = g_psGlyphSlots;
+    tContext sCapture;
+    char pcChar[1];
+
+    for (i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+        psSlot = &g_psGlyphSlots[i];
+        if (psSlot->ui32LastUse &&
+            psSlot->ui8Char == ui8Char &&
+            psSlot->psFont == psContext->psFont &&
+            psSlot->ui32Foreground == psContext->ui32Foreground &&
+            psSlot->ui32Background == ui32Background &&
+            psSlot->bOpaque == bOpaque) {
+            psSlot->ui32LastUse = ++g_ui32GlyphUse;
+            return psSlot;
+        }
+        if (psSlot->ui32LastUse < psOldest->ui32LastUse) psOldest = psSlot;
+    }
+
+    // render the glyph with grlib into the oldest slot
+    pcChar[0] = ui8Char;
+    ui32Width = GrStringWidthGet(psContext, pcChar, 1);
+    ui32Height = GrFontHeightGet(psContext->psFont);
+    if (ui32Width == 0 || ui32Width * ui32Height > GLYPH_CACHE_SLOT_PIXELS) return 0;
+
+    psSlot = psOldest;
+    psSlot->ui32LastUse = 0; // free until the capture succeeds
+    psSlot->ui8Width = ui32Width;
+    psSlot->ui8Height = ui32Height;
+    g_psCaptureSlot = psSlot;
+    g_bCaptureFailed = false;
+    memset(g_pui8CaptureMask, 0, ui32Width * ui32Height);
+
+    sCapture = *psContext; // same font and translated colors
+    sCapture.psDisplay = &g_sGlyphCapture;
+    sCapture.sClipRegion.i16XMin = 0;
+    sCapture.sClipRegion.i16YMin = 0;
+    sCapture.sClipRegion.i16XMax = ui32Width - 1;
+    sCapture.sClipRegion.i16YMax = ui32Height - 1;
+    g_sGlyphCapture.ui16Width = ui32Width;
+    g_sGlyphCapture.ui16Height = ui32Height;
+    GrStringDraw(&sCapture, pcChar, 1, 0, 0, bOpaque);
+    if (g_bCaptureFailed) return 0;
+
+    // collect the runs of written pixels
+    psSlot->ui8Runs = 0;
+    for (ui32Row = 0; ui32Row < ui32Height; ui32Row++) {
+        const uint8_t *pui8Mask = &g_pui8CaptureMask[ui32Row * ui32Width];
+        for (i = 0; i < ui32Width; i++) {
+            if (!pui8Mask[i]) continue;
+            if (psSlot->ui8Runs == GLYPH_CACHE_SLOT_RUNS) return 0;
+            psSlot->psRuns[psSlot->ui8Runs].ui8Y = ui32Row;
+            psSlot->psRuns[psSlot->ui8Runs].ui8X = i;
+            while (i < ui32Width && pui8Mask[i]) i++;
+            psSlot->psRuns[psSlot->ui8Runs].ui8Count = i - psSlot->psRuns[psSlot->ui8Runs].ui8X;
+            psSlot->ui8Runs++;
+        }
+    }
+
+    psSlot->psFont = psContext->psFont;
+    psSlot->ui32Foreground = psContext->ui32Foreground;
+    psSlot->ui32Background = ui32Background;
+    psSlot->ui8Char = ui8Char;
+    psSlot->bOpaque = bOpaque;
+    psSlot->ui32LastUse = ++g_ui32GlyphUse;
+    return psSlot;
+}
+#endif
+
+
+//*****************************************************************************
+//
+//! Draws a string like GrStringDraw, from cached glyphs where possible.
+//!
+//! \param psContext is a pointer to the drawing context to use.
+//! \param pcString is a pointer to the string to be drawn.
+//! \param i32Length is the number of characters from the string that should
+//! be drawn on the screen, or -1 for the whole string.
+//! \param i32X is the X coordinate of the upper left corner of the string.
+//! \param i32Y is the Y coordinate of the upper left corner of the string.
+//! \param bOpaque is \b true if the background of each character should also
+//! be drawn and \b false if it should not (leaving the background as is).
+//!
+//! Each character is looked up by font, character code, foreground color
+//! and, if opaque, background color. A cached glyph is copied into the frame
+//! buffer a run of pixels at a time; a missing one is rendered by grlib once
+//! and cached. Characters that cross the clip region are drawn by grlib.
+//! The string is taken as single-byte characters.
+//!
+//! Without an RGB565 frame buffer (LCD_BPP != 16) this is GrStringDraw.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void GlyphCache_StringDraw(const tContext *psContext, const char *pcString,
+                           int32_t i32Length, int32_t i32X, int32_t i32Y,
+                           bool bOpaque)
+{
+#if LCD_BPP == 16
+    const tRectangle *psClip = &psContext->sClipRegion;
+    const tGlyphSlot *psSlot;
+    const tGlyphRun *psRun;
+    uint32_t i;
+
+    for (; i32Length && *pcString; i32Length--, pcString++) {
+        psSlot = GlyphCache_Lookup(psContext, (uint8_t)*pcString, bOpaque);
+        if (!psSlot ||
+            i32X < psClip->i16XMin || i32X + psSlot->ui8Width - 1 > psClip->i16XMax ||
+            i32Y < psClip->i16YMin || i32Y + psSlot->ui8Height - 1 > psClip->i16YMax) {
+            GrStringDraw(psContext, pcString, 1, i32X, i32Y, bOpaque);
+            i32X += GrStringWidthGet(psContext, pcString, 1);
+            continue;
+        }
+
+        for (i = 0, psRun = psSlot->psRuns; i < psSlot->ui8Runs; i++, psRun++) {
+            DpyPixelDrawMultiple(psContext->psDisplay, i32X + psRun->ui8X, i32Y + psRun->ui8Y,
+                                 0, psRun->ui8Count, 16,
+                                 (const uint8_t *)&psSlot->pui16Pixels[psRun->ui8Y * psSlot->ui8Width + psRun->ui8X],
+                                 0);
+        }
+        i32X += psSlot->ui8Width;
+    }
+#else
+    GrStringDraw(psContext, pcString, i32Length, i32X, i32Y, bOpaque);
+#endif
+}
+
+
+//*****************************************************************************
+//
+//! Draws a string centered on a point like GrStringDrawCentered, from cached
+//! glyphs where possible.
+//!
+//! \param psContext is a pointer to the drawing context to use.
+//! \param pcString is a pointer to the string to be drawn.
+//! \param i32Length is the number of characters from the string that should
+//! be drawn on the screen, or -1 for the whole string.
+//! \param i32X is the X coordinate of the center of the string.
+//! \param i32Y is the Y coordinate of the center of the string.
+//! \param bOpaque is \b true if the background of each character should also
+//! be drawn and \b false if it should not.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void GlyphCache_StringDrawCentered(const tContext *psContext, const char *pcString,
+                                   int32_t i32Length, int32_t i32X, int32_t i32Y,
+                                   bool bOpaque)
+{
+    GlyphCache_StringDraw(psContext, pcString, i32Length,
+                          i32X - GrStringWidthGet(psContext, pcString, i32Length) / 2,
+                          i32Y - GrFontBaselineGet(psContext->psFont) / 2, bOpaque);
+}
+
+
+//*****************************************************************************
+//
+//! Empties the glyph cache.
+//!
+//! Glyphs are keyed by the address of their font; call this after changing
+//! a font in RAM or reusing its memory for another font.
+//!
+//! \return None.
+//
+//*****************************************************************************
+void GlyphCache_Clear(void)
+{
+#if LCD_BPP == 16
+    uint32_t i;
+    for (i = 0; i < GLYPH_CACHE_SLOTS; i++) {
+        g_psGlyphSlots[i].ui32LastUse = 0;
+    }
+#endif
+}
@@ -0,0 +1,39 @@
+//*****************************************************************************
+//
+// GlyphCache.h - Prototypes for the cache of pre-rendered grlib glyphs.
+//
+//*****************************************************************************
+
+#ifndef __GLYPHCACHE_H__
+#define __GLYPHCACHE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "grlib/grlib.h"
+
+// Cache size: GLYPH_CACHE_SLOTS glyphs of up to GLYPH_CACHE_SLOT_PIXELS
+// pixels, each stored as at most GLYPH_CACHE_SLOT_RUNS horizontal runs.
+// The defaults hold 32 glyphs of the 6x8 font in about 7 KB. Glyphs that do
+// not fit are drawn by grlib every time; the least recently used glyph makes
+// room for a new one.
+#ifndef GLYPH_CACHE_SLOTS
+#define GLYPH_CACHE_SLOTS         32
+#endif
+#ifndef GLYPH_CACHE_SLOT_PIXELS
+#define GLYPH_CACHE_SLOT_PIXELS   64
+#endif
+#ifndef GLYPH_CACHE_SLOT_RUNS
+#define GLYPH_CACHE_SLOT_RUNS     24
+#endif
+
+extern void GlyphCache_StringDraw(const tContext *psContext, const char *pcString,
+                                  int32_t i32Length, int32_t i32X, int32_t i32Y,
+                                  bool bOpaque);
+
+extern void GlyphCache_StringDrawCentered(const tContext *psContext, const char *pcString,
+                                          int32_t i32Length, int32_t i32X, int32_t i32Y,
+                                          bool bOpaque);
+
+extern void GlyphCache_Clear(void);
+
+#endif /* __GLYPHCACHE_H__ */
@@ -43,12 +43,64 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+#include "Crystalfontz128x128_ST7735.h"
 #include "grlib/grlib.h"
 #include "inc/hw_memmap.h"
+#include "inc/hw_types.h"
+#include "inc/hw_ints.h"
+#include "inc/hw_ssi.h"
 #include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
 #include "driverlib/ssi.h"
 #include "driverlib/sysctl.h"
 #include "driverlib/pin_map.h"
+#if LCD_USE_UDMA
+#include "driverlib/udma.h"
+#endif
+
+// State of the interrupt-driven transfer (see HAL_LCD_startTransfer())
+static const tLcdTransfer *g_psTransferFirst;  // first step
+static const tLcdTransfer *g_psTransferEnd;    // one past the last step
+static const tLcdTransfer *g_psTransfer;       // step being sent
+static void (*g_pfnTransferDone)(void);
+static volatile bool g_bTransferBusy;
+static volatile uint32_t g_ui32TransferPosition;
+static bool g_bTransferIntRegistered;
+static bool g_bTransferDraining;               // waiting for the end of transmission
+#if LCD_BPP != 16
+#if !LCD_USE_UDMA
+static uint16_t g_pui16TransferLine[LCD_HORIZONTAL_MAX];    // indexed row expanded to pixels
+#else
+static uint16_t g_ppui16TransferLine[2][LCD_HORIZONTAL_MAX]; // one per control structure
+#endif
+#endif
+
+#if !LCD_USE_UDMA
+static uint32_t g_ui32TransferRow;             // row being sent within the step
+static uint32_t g_ui32TransferByte;            // next byte within the row
+static bool g_bTransferCommandSent;            // command byte of the step sent
+#else
+// uDMA control table. If the application has already set one up, that one is
+// used instead and this one stays unused.
+#if defined(ccs)
+#pragma DATA_ALIGN(g_psLcdDMAControlTable, 1024)
+static tDMAControlTable g_psLcdDMAControlTable[64];
+#else
+static tDMAControlTable g_psLcdDMAControlTable[64] __attribute__ ((aligned(1024)));
+#endif
+
+#define LCD_UDMA_MAX_ITEMS  1024 // per control structure
+
+// Ping-pong state of the step being streamed. Index 0 is the primary control
+// structure, index 1 the alternate one.
+static uint32_t g_ui32StepBytes;        // data bytes in the step
+static uint32_t g_ui32ItemBytes;        // bytes per uDMA item (SSI frame) in the step
+static uint32_t g_ui32ChunkOffset;      // step offset of the next chunk to load
+static uint32_t g_pui32ChunkOffset[2];  // step offset of the chunk loaded in each structure
+static bool g_pbChunkLoaded[2];
+static uint32_t g_ui32ChunkOldest;      // structure that completes next
+static bool g_bStepStreaming;           // uDMA is streaming the step's data
+#endif
 
 void HAL_LCD_PortInit(void)
 {
@@ -101,14 +153,37 @@ void HAL_LCD_SpiInit(void)
 
 //*****************************************************************************
 //
-// Writes a command to the CFAF128128B-0145T.  This function implements the basic SPI
-// interface to the LCD display.
+// Switches the SSI frame size between 8 bits (commands and parameters) and
+// 16 bits (pixels). The current size is read back from SSICR0 so that a
+// reconfiguration of the SSI elsewhere (e.g. a clock change) is picked up.
+// Waits for the FIFO to drain; only the DSS field is touched, the clock
+// divider stays as it is.
 //
 //*****************************************************************************
-void HAL_LCD_writeCommand(uint8_t command)
+static void HAL_LCD_setFrameWidth(uint32_t ui32Bits)
+{
+    uint32_t ui32CR0 = HWREG(LCD_SSI_BASE + SSI_O_CR0);
+
+    if ((ui32CR0 & SSI_CR0_DSS_M) == ui32Bits - 1) return;
+
+    while (SSIBusy(LCD_SSI_BASE));
+    SSIDisable(LCD_SSI_BASE);
+    HWREG(LCD_SSI_BASE + SSI_O_CR0) = (ui32CR0 & ~SSI_CR0_DSS_M) | (ui32Bits - 1);
+    SSIEnable(LCD_SSI_BASE);
+}
+
+
+//*****************************************************************************
+//
+// Sends a command byte with DC low. The FIFO is drained on both sides of the
+// DC transitions so that no data byte is sampled in command mode.
+//
+//*****************************************************************************
+static void HAL_LCD_sendCommand(uint8_t command)
 {
     // Set to command mode
     while (SSIBusy(LCD_SSI_BASE)); // finish any transmission
+    HAL_LCD_setFrameWidth(LCD_SSI_DATA_WIDTH);
     GPIOPinWrite(LCD_DC_BASE, LCD_DC_PIN, 0);
 
     // Transmit data
@@ -122,13 +197,603 @@ void HAL_LCD_writeCommand(uint8_t command)
 
 //*****************************************************************************
 //
-// Writes a data to the CFAF128128B-0145T.  This function implements the basic SPI
+// Writes a command to the CFAF128128B-0145T.  This function implements the basic SPI
 // interface to the LCD display.
 //
 //*****************************************************************************
+void HAL_LCD_writeCommand(uint8_t command)
+{
+    while (g_bTransferBusy); // wait for an interrupt-driven transfer to finish
+    HAL_LCD_sendCommand(command);
+}
+
+
+//*****************************************************************************
+//
+// Writes a data to the CFAF128128B-0145T.  This function implements the basic SPI
+// interface to the LCD display. Only waits for room in the TX FIFO; the FIFO
+// is drained before the next DC transition in HAL_LCD_sendCommand().
+//
+//*****************************************************************************
 void HAL_LCD_writeData(uint8_t data)
 {
     // Transmit data
     SSIDataPut(LCD_SSI_BASE, data); // returns before data finishes transmitting
-    while (SSIBusy(LCD_SSI_BASE)); // wait for transmission to complete
+}
+
+
+//*****************************************************************************
+//
+// Writes a block of data bytes to the CFAF128128B-0145T, keeping the TX FIFO
+// full. SSIDataPut() only blocks while the FIFO has no free entry.
+//
+//*****************************************************************************
+void HAL_LCD_writeDataBurst(const uint8_t *pui8Data, uint32_t ui32Count)
+{
+    while (ui32Count--)
+    {
+        SSIDataPut(LCD_SSI_BASE, *pui8Data++);
+    }
+}
+
+
+//*****************************************************************************
+//
+// Writes a run of frame buffer pixels to the CFAF128128B-0145T so that the
+// panel receives big-endian RGB565. With LCD_SSI_PIXEL_16BIT each pixel is
+// one 16-bit frame and the SSI is left in 16-bit mode until the next command.
+// Otherwise each pixel is sent low byte first, which is the byte-swapped
+// order the frame buffer stores them in.
+//
+//*****************************************************************************
+void HAL_LCD_writePixelBurst(const uint16_t *pui16Pixels, uint32_t ui32Count)
+{
+#if LCD_SSI_PIXEL_16BIT
+    HAL_LCD_setFrameWidth(16);
+    while (ui32Count--)
+    {
+        SSIDataPut(LCD_SSI_BASE, *pui16Pixels++);
+    }
+#else
+    uint16_t data;
+
+    while (ui32Count--)
+    {
+        data = *pui16Pixels++;
+        SSIDataPut(LCD_SSI_BASE, (uint8_t)data);
+        SSIDataPut(LCD_SSI_BASE, (uint8_t)(data >> 8));
+    }
+#endif
+}
+
+
+//*****************************************************************************
+//
+// Writes a run of palette-indexed frame buffer pixels to the CFAF128128B-0145T,
+// looking each index up in pui16Palette (entries in the frame buffer pixel
+// format of HAL_LCD_writePixelBurst()). ui32Bits is 8, or 4 for two pixels
+// per byte with the left one in the upper nibble; ui32Count is in pixels.
+//
+//*****************************************************************************
+void HAL_LCD_writeIndexedBurst(const uint8_t *pui8Indices, uint32_t ui32Count,
+                               uint32_t ui32Bits, const uint16_t *pui16Palette)
+{
+    uint32_t ui32Index;
+
+#if LCD_SSI_PIXEL_16BIT
+    HAL_LCD_setFrameWidth(16);
+#endif
+    for (; ui32Count; ui32Count--)
+    {
+        if (ui32Bits == 4)
+        {
+            ui32Index = (ui32Count & 1) ? (*pui8Indices++ & 15) : (*pui8Indices >> 4);
+        }
+        else
+        {
+            ui32Index = *pui8Indices++;
+        }
+#if LCD_SSI_PIXEL_16BIT
+        SSIDataPut(LCD_SSI_BASE, pui16Palette[ui32Index]);
+#else
+        SSIDataPut(LCD_SSI_BASE, (uint8_t)pui16Palette[ui32Index]);
+        SSIDataPut(LCD_SSI_BASE, (uint8_t)(pui16Palette[ui32Index] >> 8));
+#endif
+    }
+}
+
+
+#if LCD_BPP != 16
+//*****************************************************************************
+//
+// Expands one row of an indexed transfer step into frame buffer pixels.
+// Returns the size of the expanded row in bytes.
+//
+//*****************************************************************************
+static uint32_t HAL_LCD_expandRow(const tLcdTransfer *psTransfer, const uint8_t *pui8Src,
+                                  uint16_t *pui16Line)
+{
+    const uint16_t *pui16Palette = psTransfer->pui16Palette;
+    uint32_t ui32Bytes = psTransfer->ui16RowBytes;
+    uint32_t ui32Pixels = ui32Bytes;
+
+    if (psTransfer->ui8IndexBits == 4)
+    {
+        ui32Pixels = ui32Bytes * 2;
+        while (ui32Bytes--)
+        {
+            *pui16Line++ = pui16Palette[*pui8Src >> 4];
+            *pui16Line++ = pui16Palette[*pui8Src++ & 15];
+        }
+    }
+    else
+    {
+        while (ui32Bytes--)
+        {
+            *pui16Line++ = pui16Palette[*pui8Src++];
+        }
+    }
+    return ui32Pixels * sizeof(uint16_t);
+}
+#endif
+
+
+//*****************************************************************************
+//
+// Selects when the SSI TX interrupt fires: when the TX FIFO is half full or
+// less (false), or at the end of transmission, once the FIFO is empty and the
+// last bit has been shifted out (true, SSICR1.EOT).
+//
+//*****************************************************************************
+static void HAL_LCD_setEndOfTransmission(bool bEnable)
+{
+    if (bEnable)
+    {
+        HWREG(LCD_SSI_BASE + SSI_O_CR1) |= SSI_CR1_EOT;
+    }
+    else
+    {
+        HWREG(LCD_SSI_BASE + SSI_O_CR1) &= ~SSI_CR1_EOT;
+    }
+}
+
+
+#if !LCD_USE_UDMA
+//*****************************************************************************
+//
+// SSI TX interrupt handler. Refills the TX FIFO from the transfer list each
+// time it drops to half full, and returns once the FIFO is full again.
+// Before the DC transition of the next command, and before reporting
+// completion, the FIFO (up to 8 frames, 16 bytes with 16-bit pixel frames)
+// must drain; the handler switches to the end-of-transmission interrupt and
+// returns instead of waiting for it. The only wait left in the handler is
+// the command byte itself going out (8 bit times).
+//
+//*****************************************************************************
+static void HAL_LCD_SSIIntHandler(void)
+{
+    const tLcdTransfer *psTransfer = g_psTransfer;
+    const uint8_t *pui8Data;
+    uint32_t ui32RowBytes;
+
+    if (g_bTransferDraining)
+    {
+        // end of transmission: the FIFO is empty and the last frame is out
+        g_bTransferDraining = false;
+        HAL_LCD_setEndOfTransmission(false);
+        if (psTransfer == g_psTransferEnd)
+        {
+            SSIIntDisable(LCD_SSI_BASE, SSI_TXFF);
+            g_bTransferBusy = false;
+            if (g_pfnTransferDone) g_pfnTransferDone();
+            return;
+        }
+    }
+
+    while (psTransfer != g_psTransferEnd)
+    {
+        if (!g_bTransferCommandSent)
+        {
+            if (SSIBusy(LCD_SSI_BASE))
+            {
+                // the previous step is still going out: change DC once it has
+                g_psTransfer = psTransfer;
+                g_bTransferDraining = true;
+                HAL_LCD_setEndOfTransmission(true);
+                return;
+            }
+            HAL_LCD_sendCommand(psTransfer->ui8Command);
+#if LCD_SSI_PIXEL_16BIT
+            if (psTransfer->bPixels) HAL_LCD_setFrameWidth(16); // FIFO is empty here
+#endif
+            g_bTransferCommandSent = true;
+        }
+
+        if (g_ui32TransferRow < psTransfer->ui16Rows)
+        {
+            pui8Data = psTransfer->pui8Data + g_ui32TransferRow * psTransfer->ui16RowStride;
+            ui32RowBytes = psTransfer->ui16RowBytes;
+#if LCD_BPP != 16
+            if (psTransfer->pui16Palette)
+            {
+                // indexed pixels: expand the row once, then send it from the line buffer
+                if (g_ui32TransferByte == 0) HAL_LCD_expandRow(psTransfer, pui8Data, g_pui16TransferLine);
+                ui32RowBytes = psTransfer->ui16RowBytes * (16 / psTransfer->ui8IndexBits);
+                pui8Data = (const uint8_t *)g_pui16TransferLine;
+            }
+#endif
+            pui8Data += g_ui32TransferByte;
+#if LCD_SSI_PIXEL_16BIT
+            if (psTransfer->bPixels)
+            {
+                while (g_ui32TransferByte < ui32RowBytes)
+                {
+                    if (!SSIDataPutNonBlocking(LCD_SSI_BASE, *(const uint16_t *)pui8Data))
+                    {
+                        g_psTransfer = psTransfer;
+                        return;
+                    }
+                    pui8Data += sizeof(uint16_t);
+                    g_ui32TransferByte += sizeof(uint16_t);
+                }
+            }
+#endif
+            while (g_ui32TransferByte < ui32RowBytes)
+            {
+                if (!SSIDataPutNonBlocking(LCD_SSI_BASE, *pui8Data))
+                {
+                    g_psTransfer = psTransfer; // FIFO full: resume on the next interrupt
+                    return;
+                }
+                pui8Data++;
+                g_ui32TransferByte++;
+            }
+            g_ui32TransferByte = 0;
+            g_ui32TransferRow++;
+        }
+        else
+        {
+            psTransfer++; // next step
+            g_ui32TransferRow = 0;
+            g_bTransferCommandSent = false;
+        }
+        g_ui32TransferPosition = ((uint32_t)(psTransfer - g_psTransferFirst) << 16) | g_ui32TransferRow;
+    }
+
+    // everything is queued: report completion at the end of transmission
+    g_psTransfer = psTransfer;
+    g_bTransferDraining = true;
+    HAL_LCD_setEndOfTransmission(true);
+}
+
+#else
+//*****************************************************************************
+//
+// Loads the next chunk of the current step's data into control structure
+// ui32Alt (0 = primary, 1 = alternate). A chunk is one row, or up to
+// LCD_UDMA_MAX_ITEMS frames when the rows are contiguous. Rows of palette
+// indices are expanded into the structure's own line buffer. Returns false
+// when the step has no data left.
+//
+//*****************************************************************************
+static bool HAL_LCD_loadChunk(uint32_t ui32Alt)
+{
+    const tLcdTransfer *psTransfer = g_psTransfer;
+    const uint8_t *pui8Src;
+    uint32_t ui32Offset = g_ui32ChunkOffset;
+    uint32_t ui32Count, ui32Items;
+
+    if (ui32Offset >= g_ui32StepBytes) return false;
+
+#if LCD_BPP != 16
+    if (psTransfer->pui16Palette)
+    {
+        // indexed pixels: one row per chunk, expanded into the structure's line buffer
+        ui32Count = psTransfer->ui16RowBytes;
+        ui32Items = HAL_LCD_expandRow(psTransfer,
+                                      psTransfer->pui8Data + (ui32Offset / ui32Count) * psTransfer->ui16RowStride,
+                                      g_ppui16TransferLine[ui32Alt]) / g_ui32ItemBytes;
+        pui8Src = (const uint8_t *)g_ppui16TransferLine[ui32Alt];
+    }
+    else
+#endif
+    if (psTransfer->ui16RowBytes == psTransfer->ui16RowStride)
+    {
+        pui8Src = psTransfer->pui8Data + ui32Offset;
+        ui32Count = g_ui32StepBytes - ui32Offset;
+        if (ui32Count > LCD_UDMA_MAX_ITEMS * g_ui32ItemBytes) ui32Count = LCD_UDMA_MAX_ITEMS * g_ui32ItemBytes;
+        ui32Items = ui32Count / g_ui32ItemBytes;
+    }
+    else
+    {
+        pui8Src = psTransfer->pui8Data + (ui32Offset / psTransfer->ui16RowBytes) * psTransfer->ui16RowStride;
+        ui32Count = psTransfer->ui16RowBytes;
+        ui32Items = ui32Count / g_ui32ItemBytes;
+    }
+
+    uDMAChannelTransferSet(LCD_UDMA_CHANNEL | (ui32Alt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT),
+                           UDMA_MODE_PINGPONG, (void *)pui8Src,
+                           (void *)(LCD_SSI_BASE + SSI_O_DR), ui32Items);
+    g_pui32ChunkOffset[ui32Alt] = ui32Offset;
+    g_pbChunkLoaded[ui32Alt] = true;
+    g_ui32ChunkOffset = ui32Offset + ui32Count;
+    return true;
+}
+
+
+//*****************************************************************************
+//
+// Sets the SSI frame size and the uDMA item size of both control structures
+// for the next streamed step: 1 byte per frame for command parameters, 2 for
+// pixels in 16-bit mode. Called with the FIFO empty and the channel idle.
+//
+//*****************************************************************************
+static void HAL_LCD_setItemSize(uint32_t ui32Bytes)
+{
+    uint32_t ui32Control = ui32Bytes == 2 ?
+                           (UDMA_SIZE_16 | UDMA_SRC_INC_16 | UDMA_DST_INC_NONE | UDMA_ARB_4) :
+                           (UDMA_SIZE_8 | UDMA_SRC_INC_8 | UDMA_DST_INC_NONE | UDMA_ARB_4);
+
+    HAL_LCD_setFrameWidth(ui32Bytes * 8);
+    if (ui32Bytes == g_ui32ItemBytes) return;
+    uDMAChannelControlSet(LCD_UDMA_CHANNEL | UDMA_PRI_SELECT, ui32Control);
+    uDMAChannelControlSet(LCD_UDMA_CHANNEL | UDMA_ALT_SELECT, ui32Control);
+    g_ui32ItemBytes = ui32Bytes;
+}
+
+
+//*****************************************************************************
+//
+// Updates the transfer position from the oldest chunk still in flight.
+//
+//*****************************************************************************
+static void HAL_LCD_updatePosition(void)
+{
+    uint32_t ui32Offset = g_pbChunkLoaded[g_ui32ChunkOldest] ?
+                          g_pui32ChunkOffset[g_ui32ChunkOldest] : g_ui32StepBytes;
+    g_ui32TransferPosition = ((uint32_t)(g_psTransfer - g_psTransferFirst) << 16) |
+                             (ui32Offset / g_psTransfer->ui16RowBytes);
+}
+
+
+//*****************************************************************************
+//
+// Has the SSI interrupt handler run again at the end of transmission. The
+// uDMA engine otherwise only uses the uDMA completion interrupt, so the TX
+// interrupt is enabled just for this.
+//
+//*****************************************************************************
+static void HAL_LCD_waitEndOfTransmission(void)
+{
+    g_bTransferDraining = true;
+    HAL_LCD_setEndOfTransmission(true);
+    SSIIntEnable(LCD_SSI_BASE, SSI_TXFF);
+}
+
+
+//*****************************************************************************
+//
+// Starts the next step that has not been sent yet. The command byte and any
+// data that fits in the FIFO are written by the CPU; larger data blocks are
+// handed to the uDMA channel in ping-pong mode. Reports completion when no
+// steps are left.
+//
+//*****************************************************************************
+static void HAL_LCD_nextStep(void)
+{
+    const tLcdTransfer *psTransfer;
+    const uint8_t *pui8Data;
+    uint32_t ui32Row, ui32Byte;
+
+    for (; g_psTransfer != g_psTransferEnd; g_psTransfer++)
+    {
+        psTransfer = g_psTransfer;
+        g_ui32TransferPosition = (uint32_t)(psTransfer - g_psTransferFirst) << 16;
+        if (SSIBusy(LCD_SSI_BASE))
+        {
+            // the previous step is still going out: change DC once it has
+            HAL_LCD_waitEndOfTransmission();
+            return;
+        }
+        HAL_LCD_sendCommand(psTransfer->ui8Command);
+
+        g_ui32StepBytes = (uint32_t)psTransfer->ui16RowBytes * psTransfer->ui16Rows;
+        if (g_ui32StepBytes <= LCD_SSI_FIFO_DEPTH)
+        {
+            // command parameters: cheaper to write than to set up a uDMA transfer
+            for (ui32Row = 0; ui32Row < psTransfer->ui16Rows; ui32Row++)
+            {
+                pui8Data = psTransfer->pui8Data + ui32Row * psTransfer->ui16RowStride;
+#if LCD_BPP != 16
+                if (psTransfer->pui16Palette)
+                {
+                    HAL_LCD_writeIndexedBurst(pui8Data,
+                                              psTransfer->ui16RowBytes * 8 / psTransfer->ui8IndexBits,
+                                              psTransfer->ui8IndexBits, psTransfer->pui16Palette);
+                    continue;
+                }
+#endif
+#if LCD_SSI_PIXEL_16BIT
+                if (psTransfer->bPixels)
+                {
+                    HAL_LCD_writePixelBurst((const uint16_t *)pui8Data,
+                                            psTransfer->ui16RowBytes / sizeof(uint16_t));
+                    continue;
+                }
+#endif
+                for (ui32Byte = 0; ui32Byte < psTransfer->ui16RowBytes; ui32Byte++)
+                {
+                    SSIDataPut(LCD_SSI_BASE, pui8Data[ui32Byte]);
+                }
+            }
+            continue;
+        }
+
+        HAL_LCD_setItemSize(psTransfer->bPixels && LCD_SSI_PIXEL_16BIT ? 2 : 1);
+        g_ui32ChunkOffset = 0;
+        g_ui32ChunkOldest = 0;
+        HAL_LCD_loadChunk(0);
+        HAL_LCD_loadChunk(1);
+        g_bStepStreaming = true;
+        uDMAChannelAttributeDisable(LCD_UDMA_CHANNEL, UDMA_ATTR_ALTSELECT);
+        uDMAChannelEnable(LCD_UDMA_CHANNEL);
+        return;
+    }
+
+    // all steps sent: report completion once the FIFO has drained
+    if (SSIBusy(LCD_SSI_BASE))
+    {
+        HAL_LCD_waitEndOfTransmission();
+        return;
+    }
+    g_bTransferBusy = false;
+    if (g_pfnTransferDone) g_pfnTransferDone();
+}
+
+
+//*****************************************************************************
+//
+// SSI interrupt handler for the uDMA engine. Runs each time a control
+// structure finishes: the structure is reloaded with the next chunk while
+// the other one keeps the FIFO fed. Once the step's data has been sent, the
+// next step is started; if the FIFO still holds the end of the previous
+// step, that happens from the end-of-transmission interrupt.
+//
+//*****************************************************************************
+static void HAL_LCD_SSIIntHandler(void)
+{
+    uint32_t ui32Alt;
+
+    SSIIntClear(LCD_SSI_BASE, SSI_DMATX);
+
+    if (!g_bTransferBusy) return;
+
+    if (g_bTransferDraining)
+    {
+        // end of transmission: the FIFO is empty and the last frame is out
+        g_bTransferDraining = false;
+        SSIIntDisable(LCD_SSI_BASE, SSI_TXFF);
+        HAL_LCD_setEndOfTransmission(false);
+        HAL_LCD_nextStep();
+        return;
+    }
+
+    // retire finished structures, oldest first, and refill them
+    while (g_pbChunkLoaded[ui32Alt = g_ui32ChunkOldest] &&
+           uDMAChannelModeGet(LCD_UDMA_CHANNEL | (ui32Alt ? UDMA_ALT_SELECT : UDMA_PRI_SELECT))
+           == UDMA_MODE_STOP)
+    {
+        g_pbChunkLoaded[ui32Alt] = false;
+        g_ui32ChunkOldest = ui32Alt ^ 1;
+        HAL_LCD_loadChunk(ui32Alt);
+    }
+
+    if (g_pbChunkLoaded[0] || g_pbChunkLoaded[1])
+    {
+        HAL_LCD_updatePosition();
+        if (!uDMAChannelIsEnabled(LCD_UDMA_CHANNEL))
+        {
+            // both structures ran out before this interrupt was served:
+            // resume from the oldest chunk
+            if (g_ui32ChunkOldest) uDMAChannelAttributeEnable(LCD_UDMA_CHANNEL, UDMA_ATTR_ALTSELECT);
+            else uDMAChannelAttributeDisable(LCD_UDMA_CHANNEL, UDMA_ATTR_ALTSELECT);
+            uDMAChannelEnable(LCD_UDMA_CHANNEL);
+        }
+        return;
+    }
+
+    if (g_bStepStreaming)
+    {
+        g_bStepStreaming = false;
+        g_psTransfer++;
+    }
+    HAL_LCD_nextStep();
+}
+
+
+//*****************************************************************************
+//
+// One-time uDMA setup for the SSI TX channel.
+//
+//*****************************************************************************
+static void HAL_LCD_DMAInit(void)
+{
+    SysCtlPeripheralEnable(SYSCTL_PERIPH_UDMA);
+    while (!SysCtlPeripheralReady(SYSCTL_PERIPH_UDMA));
+    uDMAEnable();
+    if (uDMAControlBaseGet() == 0) uDMAControlBaseSet(g_psLcdDMAControlTable);
+
+    uDMAChannelAssign(LCD_UDMA_CHANNEL);
+    uDMAChannelAttributeDisable(LCD_UDMA_CHANNEL, UDMA_ATTR_ALL);
+    uDMAChannelAttributeEnable(LCD_UDMA_CHANNEL, UDMA_ATTR_HIGH_PRIORITY);
+    // the control words are set per step by HAL_LCD_setItemSize()
+
+    SSIDMAEnable(LCD_SSI_BASE, SSI_DMA_TX);
+    SSIIntEnable(LCD_SSI_BASE, SSI_DMATX);
+}
+#endif
+
+
+//*****************************************************************************
+//
+// Starts sending a list of transfer steps from the SSI interrupt and returns
+// immediately. The steps and the data they point to must stay valid until
+// pfnDone is called (from interrupt context) or HAL_LCD_isTransferBusy()
+// returns false. A transfer already in progress is completed first.
+//
+//*****************************************************************************
+void HAL_LCD_startTransfer(const tLcdTransfer *psTransfers, uint32_t ui32Count,
+                           void (*pfnDone)(void))
+{
+    while (g_bTransferBusy);
+
+    if (!g_bTransferIntRegistered)
+    {
+#if LCD_USE_UDMA
+        HAL_LCD_DMAInit();
+#endif
+        SSIIntRegister(LCD_SSI_BASE, HAL_LCD_SSIIntHandler);
+        g_bTransferIntRegistered = true;
+    }
+
+    g_psTransferFirst = psTransfers;
+    g_psTransferEnd = psTransfers + ui32Count;
+    g_psTransfer = psTransfers;
+    g_pfnTransferDone = pfnDone;
+    g_ui32TransferPosition = 0;
+    g_bTransferBusy = true;
+    g_bTransferDraining = false;
+
+#if LCD_USE_UDMA
+    IntTrigger(LCD_SSI_INT); // the first step is started from the interrupt handler
+#else
+    g_ui32TransferRow = 0;
+    g_ui32TransferByte = 0;
+    g_bTransferCommandSent = false;
+    SSIIntEnable(LCD_SSI_BASE, SSI_TXFF); // FIFO is empty: fires right away
+#endif
+}
+
+
+//*****************************************************************************
+//
+// Returns true while an interrupt-driven transfer is in progress.
+//
+//*****************************************************************************
+bool HAL_LCD_isTransferBusy(void)
+{
+    return g_bTransferBusy;
+}
+
+
+//*****************************************************************************
+//
+// Returns the step and row the interrupt-driven transfer is currently
+// sending. Use HAL_LCD_TRANSFER_STEP() and HAL_LCD_TRANSFER_ROW() to unpack.
+// Everything before that row has been written to the SSI FIFO.
+//
+//*****************************************************************************
+uint32_t HAL_LCD_transferPosition(void)
+{
+    return g_ui32TransferPosition;
 }
@@ -43,6 +43,7 @@
 #define __HAL_EK_TM4C1294XL_CRYSTALFONTZLCD_H_
 
 #include <stdint.h>
+#include <stdbool.h>
 #include "driverlib/sysctl.h"
 
 //*****************************************************************************
@@ -85,6 +86,45 @@
 #define LCD_SSI_BASE        SSI2_BASE
 #define LCD_SSI_PROTOCOL    SSI_FRF_MOTO_MODE_0
 #define LCD_SSI_DATA_WIDTH  8 // bits
+#define LCD_SSI_INT         INT_SSI2
+#define LCD_SSI_FIFO_DEPTH  8 // frames
+
+// Pixel data format during CM_RAMWR:
+// 0 = two 8-bit frames per pixel, frame buffer holds byte-swapped RGB565,
+// 1 = one 16-bit frame per pixel, frame buffer holds native RGB565
+#ifndef LCD_SSI_PIXEL_16BIT
+#define LCD_SSI_PIXEL_16BIT 1
+#endif
+
+// Engine for interrupt-driven transfers (asynchronous flush):
+// 0 = CPU refills the SSI TX FIFO from its interrupt,
+// 1 = uDMA streams the data blocks, the SSI interrupt only runs between blocks
+#ifndef LCD_USE_UDMA
+#define LCD_USE_UDMA        0
+#endif
+#define LCD_UDMA_CHANNEL    UDMA_CH13_SSI2TX
+
+//*****************************************************************************
+//
+// One step of an interrupt-driven transfer: a command byte followed by
+// ui16Rows rows of ui16RowBytes data bytes each. Row n starts at
+// pui8Data + n * ui16RowStride. When bPixels is set the data is frame buffer
+// pixels and is sent in the LCD_SSI_PIXEL_16BIT format: RGB565 pixels
+// (ui16RowBytes even) if pui16Palette is NULL, otherwise ui8IndexBits-bit
+// (8 or 4) indices that are expanded through pui16Palette on the fly.
+//
+//*****************************************************************************
+typedef struct
+{
+    const uint8_t *pui8Data;
+    uint16_t ui16RowBytes;
+    uint16_t ui16RowStride;
+    uint16_t ui16Rows;
+    uint8_t ui8Command;
+    bool bPixels;
+    uint8_t ui8IndexBits;
+    const uint16_t *pui16Palette;
+} tLcdTransfer;
 
 //*****************************************************************************
 //
@@ -93,8 +133,21 @@
 //*****************************************************************************
 extern void HAL_LCD_writeCommand(uint8_t command);
 extern void HAL_LCD_writeData(uint8_t data);
+extern void HAL_LCD_writeDataBurst(const uint8_t *pui8Data, uint32_t ui32Count);
+extern void HAL_LCD_writePixelBurst(const uint16_t *pui16Pixels, uint32_t ui32Count);
+extern void HAL_LCD_writeIndexedBurst(const uint8_t *pui8Indices, uint32_t ui32Count,
+                                      uint32_t ui32Bits, const uint16_t *pui16Palette);
 extern void HAL_LCD_PortInit(void);
 extern void HAL_LCD_SpiInit(void);
+extern void HAL_LCD_startTransfer(const tLcdTransfer *psTransfers, uint32_t ui32Count,
+                                  void (*pfnDone)(void));
+extern bool HAL_LCD_isTransferBusy(void);
+extern uint32_t HAL_LCD_transferPosition(void);
+
+// HAL_LCD_transferPosition() packs the transfer step in the upper 16 bits and
+// the data row being sent within that step in the lower 16 bits
+#define HAL_LCD_TRANSFER_STEP(pos)  ((pos) >> 16)
+#define HAL_LCD_TRANSFER_ROW(pos)   ((pos) & 0xffff)
 
 #define HAL_LCD_delay(x)    SysCtlDelay((x) * 40) // delay in us
 
@@ -0,0 +1,113 @@
+#ifndef FIXED_FORMAT_H
+#define FIXED_FORMAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fixed-width digit formatter
+// Formats unsigned fields as zero-padded digits joined by one separator,
+// with the field widths and separator fixed at compile time, e.g. the
+// stopwatch time "hh:mm:ss:mmm":
+//   FixedFormat<':', 2, 2, 2, 3> fmt;
+//   char text[fmt.LENGTH + 1];
+//   const uint32_t fields[] = {hr, min, sec, ms};
+//   fmt.format(text, fields);          // full rewrite
+//   if (fmt.update(text, fields)) ...  // only the digits that changed
+// Values wider than their field keep their low digits. No division: digits
+// come from a multiply by the reciprocal of 10 (one UMULL on Cortex-M4), and
+// nothing is allocated or pulled in from the printf library.
+
+// Sum of the field widths
+constexpr uint8_t fixedFormatWidth() { return 0; }
+
+template <typename... Rest>
+constexpr uint8_t fixedFormatWidth(uint8_t first, Rest... rest)
+{
+    return first + fixedFormatWidth(rest...);
+}
+
+template <char Sep, uint8_t... Widths>
+class FixedFormat {
+public:
+    static constexpr uint8_t FIELDS = sizeof...(Widths);
+    static constexpr uint8_t LENGTH = fixedFormatWidth(Widths...) + FIELDS - 1;  // without the '\0'
+
+    static_assert(FIELDS > 0, "FixedFormat needs at least one field");
+    static_assert(LENGTH <= 32, "update() reports changes in a 32-bit mask");
+
+    FixedFormat() : _valid(false) {}
+
+    // Writes all fields and the terminating '\0' to buf[LENGTH + 1]
+    static void format(char *buf, const uint32_t (&values)[FIELDS])
+    {
+        const uint8_t widths[FIELDS] = {Widths...};
+        for (uint8_t f = 0; f < FIELDS; f++) {
+            if (f) *buf++ = Sep;
+            writeDigits(buf, widths[f], values[f]);
+            buf += widths[f];
+        }
+        *buf = '\0';
+    }
+
+    // Rewrites only the fields whose value changed since the last call on
+    // the same buf (the first call, or the first after reset(), writes it
+    // all). Returns a mask with bit i set for every character of buf that
+    // changed, 0 if none did.
+    uint32_t update(char *buf, const uint32_t (&values)[FIELDS])
+    {
+        const uint8_t widths[FIELDS] = {Widths...};
+        uint32_t changed = 0;
+        uint8_t pos = 0;
+
+        if (!_valid) {
+            format(buf, values);
+            for (uint8_t f = 0; f < FIELDS; f++) _last[f] = values[f];
+            _valid = true;
+            return 0xffffffffu >> (32 - LENGTH);
+        }
+
+        for (uint8_t f = 0; f < FIELDS; f++) {
+            if (f) pos++;  // separator
+            if (values[f] != _last[f]) {
+                uint32_t v = values[f];
+                for (int i = widths[f] - 1; i >= 0; i--) {
+                    uint32_t q = div10(v);
+                    char c = static_cast<char>('0' + (v - q * 10));
+                    v = q;
+                    if (buf[pos + i] != c) {
+                        buf[pos + i] = c;
+                        changed |= 1u << (pos + i);
+                    }
+                }
+                _last[f] = values[f];
+            }
+            pos += widths[f];
+        }
+        return changed;
+    }
+
+    // Makes the next update() rewrite the whole buffer
+    void reset() { _valid = false; }
+
+private:
+    // v / 10 for any 32-bit v
+    static uint32_t div10(uint32_t v)
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(v) * 0xCCCCCCCDu) >> 35);
+    }
+
+    // Low 'width' decimal digits of v, zero-padded, into p[0 .. width - 1]
+    static void writeDigits(char *p, uint8_t width, uint32_t v)
+    {
+        for (int i = width - 1; i >= 0; i--) {
+            uint32_t q = div10(v);
+            p[i] = static_cast<char>('0' + (v - q * 10));
+            v = q;
+        }
+    }
+
+    uint32_t _last[FIELDS];
+    bool _valid;
+};
+
+#endif // FIXED_FORMAT_H
@@ -0,0 +1,257 @@
+#include "widgets.h"
+
+extern "C" {
+#include "GlyphCache.h"
+}
+
+// ============================================================================
+// Widget
+// ============================================================================
+Widget::Widget(int16_t x, int16_t y, int16_t w, int16_t h)
+    : _bounds{x, y, static_cast<int16_t>(x + w - 1), static_cast<int16_t>(y + h - 1)},
+      _dirty(true)
+{
+}
+
+bool Widget::update(tContext &context)
+{
+    if (!_dirty) return false;
+    paint(context);
+    _dirty = false;
+    return true;
+}
+
+// ============================================================================
+// Label
+// ============================================================================
+Label::Label(int16_t x, int16_t y, int16_t w, int16_t h, const char *text,
+             uint32_t fg, uint32_t bg)
+    : Widget(x, y, w, h), _text(text), _fg(fg), _bg(bg)
+{
+}
+
+void Label::setText(const char *text)
+{
+    if (text == _text) return;
+    _text = text;
+    _dirty = true;
+}
+
+void Label::setColors(uint32_t fg, uint32_t bg)
+{
+    if (fg == _fg && bg == _bg) return;
+    _fg = fg;
+    _bg = bg;
+    _dirty = true;
+}
+
+void Label::paint(tContext &context)
+{
+    GrContextForegroundSet(&context, _bg);
+    GrRectFill(&context, &_bounds);
+
+    GrContextForegroundSet(&context, _fg);
+    GlyphCache_StringDrawCentered(&context, _text, -1,
+                                  (_bounds.i16XMin + _bounds.i16XMax + 1) / 2,
+                                  (_bounds.i16YMin + _bounds.i16YMax + 1) / 2, false);
+}
+
+// ============================================================================
+// StatusText
+// ============================================================================
+StatusText::StatusText(int16_t x, int16_t y, int16_t w, int16_t h,
+                       const char *onText, uint32_t onColor,
+                       const char *offText, uint32_t offColor, uint32_t bg)
+    : Label(x, y, w, h, offText, offColor, bg),
+      _onText(onText), _offText(offText), _onColor(onColor), _offColor(offColor)
+{
+}
+
+void StatusText::set(bool on)
+{
+    setText(on ? _onText : _offText);
+    setColors(on ? _onColor : _offColor, _bg);
+}
+
+// ============================================================================
+// NumericField
+// ============================================================================
+NumericField::NumericField(int16_t x, int16_t y, uint8_t chars, int16_t charW, int16_t h,
+                           uint32_t fg, uint32_t bg)
+    : Widget(x, y, charW * (chars > MAX_CHARS ? MAX_CHARS : chars), h),
+      _chars(chars > MAX_CHARS ? MAX_CHARS : chars), _charW(charW),
+      _fg(fg), _bg(bg), _repaintAll(true)
+{
+    for (uint8_t i = 0; i < _chars; i++) {
+        _value[i] = ' ';
+        _shown[i] = ' ';
+    }
+}
+
+void NumericField::setChar(uint8_t i, char c)
+{
+    if (c == _value[i]) return;
+    _value[i] = c;
+    _dirty = true;
+}
+
+void NumericField::setText(const char *text)
+{
+    for (uint8_t i = 0; i < _chars; i++) {
+        setChar(i, *text ? *text++ : ' ');
+    }
+}
+
+void NumericField::setValue(uint32_t value)
+{
+    for (int i = _chars - 1; i >= 0; i--) {
+        setChar(i, static_cast<char>('0' + value % 10));
+        value /= 10;
+    }
+}
+
+void NumericField::setColors(uint32_t fg, uint32_t bg)
+{
+    if (fg == _fg && bg == _bg) return;
+    _fg = fg;
+    _bg = bg;
+    _repaintAll = true;
+    _dirty = true;
+}
+
+void NumericField::paint(tContext &context)
+{
+    if (_repaintAll) {
+        GrContextForegroundSet(&context, _bg);
+        GrRectFill(&context, &_bounds);
+    }
+
+    // Opaque glyphs overwrite the old character, no need to clear the cell
+    GrContextForegroundSet(&context, _fg);
+    GrContextBackgroundSet(&context, _bg);
+    for (uint8_t i = 0; i < _chars; i++) {
+        if (_repaintAll || _value[i] != _shown[i]) {
+            GlyphCache_StringDraw(&context, &_value[i], 1,
+                                  _bounds.i16XMin + i * _charW, _bounds.i16YMin, true);
+            _shown[i] = _value[i];
+        }
+    }
+    _repaintAll = false;
+}
+
+// ============================================================================
+// TextList
+// ============================================================================
+TextList::TextList(int16_t x, int16_t y, int16_t w, uint8_t rows, int16_t rowH,
+                   uint32_t fg, uint32_t bg)
+    : Widget(x, y, w, rowH * (rows > MAX_ROWS ? MAX_ROWS : rows)),
+      _rows(rows > MAX_ROWS ? MAX_ROWS : rows), _rowH(rowH),
+      _dirtyRows(0xff), _fg(fg), _bg(bg)
+{
+    for (uint8_t r = 0; r < _rows; r++) {
+        _lines[r][0] = '\0';
+    }
+}
+
+void TextList::setLine(uint8_t row, const char *text)
+{
+    if (row >= _rows) return;
+    char *line = _lines[row];
+    uint8_t i = 0;
+    bool changed = false;
+    for (; i < MAX_CHARS && text[i]; i++) {
+        if (line[i] != text[i]) {
+            line[i] = text[i];
+            changed = true;
+        }
+    }
+    if (line[i] != '\0') {
+        line[i] = '\0';
+        changed = true;
+    }
+    if (changed) {
+        _dirtyRows |= 1u << row;
+        _dirty = true;
+    }
+}
+
+void TextList::push(const char *text)
+{
+    for (uint8_t r = _rows - 1; r > 0; r--) {
+        setLine(r, _lines[r - 1]);
+    }
+    setLine(0, text);
+}
+
+void TextList::clear()
+{
+    for (uint8_t r = 0; r < _rows; r++) {
+        setLine(r, "");
+    }
+}
+
+void TextList::paint(tContext &context)
+{
+    for (uint8_t r = 0; r < _rows; r++) {
+        if (!(_dirtyRows & (1u << r))) continue;
+
+        tRectangle row = {_bounds.i16XMin, static_cast<int16_t>(_bounds.i16YMin + r * _rowH),
+                          _bounds.i16XMax, static_cast<int16_t>(_bounds.i16YMin + (r + 1) * _rowH - 1)};
+        GrContextForegroundSet(&context, _bg);
+        GrRectFill(&context, &row);
+
+        if (_lines[r][0]) {
+            GrContextForegroundSet(&context, _fg);
+            GlyphCache_StringDraw(&context, _lines[r], -1, row.i16XMin, row.i16YMin, false);
+        }
+    }
+    _dirtyRows = 0;
+}
+
+// ============================================================================
+// ButtonWidget
+// ============================================================================
+ButtonWidget::ButtonWidget(int16_t x, int16_t y, int16_t w, int16_t h, const char *label)
+    : Widget(x, y, w, h), _label(label), _pressed(false)
+{
+}
+
+void ButtonWidget::setLabel(const char *label)
+{
+    if (label == _label) return;
+    _label = label;
+    _dirty = true;
+}
+
+void ButtonWidget::setPressed(bool pressed)
+{
+    if (pressed == _pressed) return;
+    _pressed = pressed;
+    _dirty = true;
+}
+
+void ButtonWidget::paint(tContext &context)
+{
+    GrContextForegroundSet(&context, _pressed ? ClrBlack : ClrGray);
+    GrRectFill(&context, &_bounds);
+
+    GrContextForegroundSet(&context, ClrBlack);
+    GrRectDraw(&context, &_bounds);
+
+    GrContextForegroundSet(&context, _pressed ? ClrWhite : ClrBlack);
+    GlyphCache_StringDrawCentered(&context, _label, -1,
+                                  (_bounds.i16XMin + _bounds.i16XMax + 1) / 2,
+                                  (_bounds.i16YMin + _bounds.i16YMax + 1) / 2, false);
+}
+
+// ============================================================================
+// Screen update
+// ============================================================================
+bool updateWidgets(tContext &context, Widget *const *widgets, uint32_t count)
+{
+    bool drew = false;
+    for (uint32_t i = 0; i < count; i++) {
+        drew |= widgets[i]->update(context);
+    }
+    return drew;
+}
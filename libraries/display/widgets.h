@@ -0,0 +1,147 @@
+#ifndef WIDGETS_H
+#define WIDGETS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+#include "grlib/grlib.h"
+}
+
+// Retained-mode widgets on top of grlib
+// Each widget keeps its bounds and the state it last drew. Setters mark the
+// widget dirty only when the value actually changes, and update() repaints a
+// dirty widget inside its bounds, so the display driver only sees (and the
+// flush only sends) the pixels that changed. The screen is not cleared
+// between frames: every widget paints its own background.
+// Usage:
+//   Label title(37, 11, 54, 8, "STOPWATCH", ClrCyan);
+//   Widget *screen[] = {&title, ...};
+//   if (updateWidgets(context, screen, count)) GrFlush(&context);
+
+class Widget {
+public:
+    Widget(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    const tRectangle &bounds() const { return _bounds; }
+    void invalidate() { _dirty = true; }  // repaint on the next update()
+    bool isDirty() const { return _dirty; }
+
+    // Repaints the widget if it changed; returns true if it drew anything
+    bool update(tContext &context);
+
+protected:
+    virtual void paint(tContext &context) = 0;
+
+    tRectangle _bounds;
+    bool _dirty;
+};
+
+// Text centered in its bounds. The text is kept by pointer and compared by
+// pointer, so pass strings that do not change (e.g. literals).
+class Label : public Widget {
+public:
+    Label(int16_t x, int16_t y, int16_t w, int16_t h, const char *text,
+          uint32_t fg, uint32_t bg = ClrBlack);
+
+    void setText(const char *text);
+    void setColors(uint32_t fg, uint32_t bg);
+
+protected:
+    void paint(tContext &context) override;
+
+    const char *_text;
+    uint32_t _fg;
+    uint32_t _bg;
+};
+
+// Label switching between two texts and colors, e.g. Running / Stopped
+class StatusText : public Label {
+public:
+    StatusText(int16_t x, int16_t y, int16_t w, int16_t h,
+               const char *onText, uint32_t onColor,
+               const char *offText, uint32_t offColor, uint32_t bg = ClrBlack);
+
+    void set(bool on);
+
+private:
+    const char *_onText;
+    const char *_offText;
+    uint32_t _onColor;
+    uint32_t _offColor;
+};
+
+// Fixed-width text of digits and separators, one character per cell, e.g.
+// a time "01:23:45:678". A new value only repaints the characters that
+// differ from the ones on screen. Meant for fixed-width fonts with cells as
+// wide as a glyph and as high as the font.
+class NumericField : public Widget {
+public:
+    static constexpr uint8_t MAX_CHARS = 16;
+
+    NumericField(int16_t x, int16_t y, uint8_t chars, int16_t charW, int16_t h,
+                 uint32_t fg, uint32_t bg = ClrBlack);
+
+    void setText(const char *text);     // first 'chars' characters of text
+    void setValue(uint32_t value);      // zero-padded number
+    void setColors(uint32_t fg, uint32_t bg);  // repaints all characters
+
+protected:
+    void paint(tContext &context) override;
+    void setChar(uint8_t i, char c);
+
+    uint8_t _chars;
+    int16_t _charW;
+    char _value[MAX_CHARS];  // characters to show
+    char _shown[MAX_CHARS];  // characters on screen
+    uint32_t _fg;
+    uint32_t _bg;
+    bool _repaintAll;
+};
+
+// Rows of left-aligned text, e.g. a lap list. push() scrolls the rows down
+// and puts the new line on top; setLine() replaces one row. Lines are copied,
+// and only the rows whose text changed are repainted.
+class TextList : public Widget {
+public:
+    static constexpr uint8_t MAX_ROWS = 8;
+    static constexpr uint8_t MAX_CHARS = 21;  // 128 px of 6 px glyphs
+
+    TextList(int16_t x, int16_t y, int16_t w, uint8_t rows, int16_t rowH,
+             uint32_t fg, uint32_t bg = ClrBlack);
+
+    void push(const char *text);
+    void setLine(uint8_t row, const char *text);
+    void clear();
+
+protected:
+    void paint(tContext &context) override;
+
+    uint8_t _rows;
+    int16_t _rowH;
+    char _lines[MAX_ROWS][MAX_CHARS + 1];
+    uint8_t _dirtyRows;  // bit per row
+    uint32_t _fg;
+    uint32_t _bg;
+};
+
+// On-screen push button: gray with black text, inverted while pressed
+class ButtonWidget : public Widget {
+public:
+    ButtonWidget(int16_t x, int16_t y, int16_t w, int16_t h, const char *label);
+
+    void setLabel(const char *label);
+    void setPressed(bool pressed);
+    bool isPressed() const { return _pressed; }
+
+protected:
+    void paint(tContext &context) override;
+
+    const char *_label;
+    bool _pressed;
+};
+
+// Updates a screen of widgets; returns true if any of them drew
+bool updateWidgets(tContext &context, Widget *const *widgets, uint32_t count);
+
+#endif // WIDGETS_H
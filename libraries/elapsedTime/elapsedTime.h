@@ -128,4 +128,124 @@ public:
     elapsedSeconds operator+(uint64_t seconds) const { elapsedSeconds r(*this); r.m_msStart -= seconds * kMsPerSec; return r; }
 };
 
+// ---------------------------------------------------------------------------
+// Tiempo transcurrido en ticks
+// elapsedMicros/Millis/Seconds guardan el origen ya convertido y leen el
+// Timer (y dividen) en cada comparación. elapsedTicks<U> guarda ticks
+// crudos: las comparaciones pasan el umbral a ticks (una multiplicación) y
+// solo la conversión explícita a unidades divide. Con un TimeSnapshot,
+// todos los medidores de una vuelta del loop comparan contra la misma
+// lectura del timer.
+// Uso típico:
+//   TimeSnapshot now(t);
+//   elapsedTickMillis buttons(now), screen(now);
+//   while (true) {
+//       now.update();                            // una lectura por vuelta
+//       if (buttons >= 20) { buttons = 0; ... }  // sin lecturas ni divisiones
+//       if (screen >= 16) { screen = 0; ... }
+//   }
+// ---------------------------------------------------------------------------
+
+// Lectura del timer compartida por una vuelta del loop
+class TimeSnapshot {
+private:
+    Timer* m_timer;
+    uint64_t m_now;
+
+public:
+    explicit TimeSnapshot(Timer& timer) : m_timer(&timer), m_now(timer.ticks()) {}
+
+    // Captura el timer; llamar una vez al principio de cada vuelta
+    void update() { m_now = m_timer->ticks(); }
+
+    uint64_t ticks() const { return m_now; }
+    Timer& timer() const { return *m_timer; }
+};
+
+// U = unidades por segundo: 1 (s), 1000 (ms), 1000000 (us)
+template <uint32_t U>
+class elapsedTicks {
+private:
+    Timer* m_timer;                 // backend si no hay snapshot
+    const TimeSnapshot* m_snap;     // si no es nulo, "ahora" es su lectura
+    uint64_t m_start;               // origen en ticks
+    uint32_t m_ticksPerUnit;
+    Reciprocal m_div;               // ticks -> unidades, solo en la conversión
+
+    void init() {
+        uint32_t hz = m_timer->clockHz();
+        m_ticksPerUnit = hz / U ? hz / U : 1;
+        m_div.set(m_ticksPerUnit);
+        m_start = now();
+    }
+
+    uint64_t now() const { return m_snap ? m_snap->ticks() : m_timer->ticks(); }
+    uint64_t toTicks(uint64_t units) const { return units * m_ticksPerUnit; }
+
+public:
+    // Construye tomando como origen la lectura actual del timer
+    explicit elapsedTicks(Timer& timer) : m_timer(&timer), m_snap(nullptr) { init(); }
+
+    // Construye sobre un snapshot: "ahora" es su última update()
+    explicit elapsedTicks(const TimeSnapshot& snap) : m_timer(&snap.timer()), m_snap(&snap) { init(); }
+
+    // Ticks transcurridos, sin convertir
+    uint64_t ticks() const { return now() - m_start; }
+
+    // Conversión a unidades (multiplicación por el recíproco, sin división)
+    operator uint64_t() const { return m_div.divide(ticks()); }
+
+    // Comparaciones en ticks: el umbral se multiplica, no se divide.
+    // Dan lo mismo que comparar (uint64_t)em, que trunca: 'em > 20' es
+    // "ya van 21 unidades enteras", no "pasó un tick de las 20".
+    // Plantillas para que 'em >= 20' no sea ambiguo con la comparación
+    // entre enteros a través de operator uint64_t().
+    template <typename T> bool operator>=(T units) const { return ticks() >= toTicks(units); }
+    template <typename T> bool operator>(T units) const  { return ticks() >= toTicks(units + 1); }
+    template <typename T> bool operator<(T units) const  { return ticks() <  toTicks(units); }
+    template <typename T> bool operator<=(T units) const { return ticks() <  toTicks(units + 1); }
+
+    // Fija el valor actual como si ya hubiesen transcurrido 'units'
+    elapsedTicks& operator=(uint64_t units) { m_start = now() - toTicks(units); return *this; }
+
+    elapsedTicks& operator-=(uint64_t units) { m_start += toTicks(units); return *this; }
+    elapsedTicks& operator+=(uint64_t units) { m_start -= toTicks(units); return *this; }
+};
+
+typedef elapsedTicks<1000000u> elapsedTickMicros;
+typedef elapsedTicks<1000u>    elapsedTickMillis;
+typedef elapsedTicks<1u>       elapsedTickSeconds;
+
+// ---------------------------------------------------------------------------
+// Ciclos transcurridos
+// Ticks del Timer sin convertir: con Timer::DWT_CYCCNT cada tick es un ciclo
+// del núcleo y la lectura no pasa por el bus de periféricos, así que sirve
+// para perfilar tramos cortos (unas decenas de ciclos). Con un GPTM los
+// ticks también van a sysclk, pero cada lectura cuesta un acceso al bus.
+// Uso típico:
+//   Timer cyc; cyc.begin(sysclkHz, Timer::DWT_CYCCNT);
+//   elapsedCycles ec(cyc);
+//   work();
+//   uint64_t c = ec;                  // ciclos de work() + una lectura
+// ---------------------------------------------------------------------------
+
+class elapsedCycles {
+private:
+    Timer* m_timer;         // backend
+    uint64_t m_start;       // origen en ticks
+
+public:
+    explicit elapsedCycles(Timer& timer)
+        : m_timer(&timer), m_start(timer.ticks()) {}
+
+    elapsedCycles(Timer& timer, uint64_t val)
+        : m_timer(&timer), m_start(timer.ticks() - val) {}
+
+    operator uint64_t() const { return m_timer->ticks() - m_start; }
+
+    elapsedCycles& operator=(uint64_t val) { m_start = m_timer->ticks() - val; return *this; }
+    elapsedCycles& operator-=(uint64_t val) { m_start += val; return *this; }
+    elapsedCycles& operator+=(uint64_t val) { m_start -= val; return *this; }
+};
+
 #endif // TM4C_ELAPSED_TIME_H
@@ -0,0 +1,149 @@
+#ifndef TM4C_LAPS_H
+#define TM4C_LAPS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+
+// Registro de vueltas (laps) del cronómetro
+// - SplitRing: cola circular productor único / consumidor único sin bloqueo.
+//   El productor (ISR del botón o callback) hace push() de un split en ticks
+//   y el consumidor (loop principal) hace pop(). Ninguno de los dos deshabilita
+//   interrupciones: cada índice lo escribe un solo lado.
+// - LapStats: mínimo, máximo, media y varianza acumuladas en O(1) por vuelta
+//   (algoritmo de Welford), sin recorrer el historial.
+// - LapRecorder: une ambos; convierte splits en vueltas y actualiza las
+//   estadísticas.
+// Uso típico:
+//   LapRecorder<16> laps;
+//   laps.split(stopwatch.elapsedTicks());        // productor
+//   LapRecorder<16>::Lap lap;
+//   while (laps.poll(lap)) { /* mostrar lap */ } // consumidor
+//   laps.stats().mean();
+
+template <uint32_t N>
+class SplitRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N debe ser potencia de 2");
+
+public:
+    SplitRing() : m_head(0), m_tail(0), m_dropped(0) {}
+
+    // Productor: false (y cuenta el descarte) si la cola está llena
+    bool push(uint64_t split) {
+        uint32_t head = m_head;
+        if (head - m_tail == N) { m_dropped = m_dropped + 1; return false; }
+        m_buf[head & (N - 1)] = split;
+        m_head = head + 1;                // publica el dato ya escrito
+        return true;
+    }
+
+    // Consumidor: false si la cola está vacía
+    bool pop(uint64_t& split) {
+        uint32_t tail = m_tail;
+        if (m_head == tail) return false;
+        split = m_buf[tail & (N - 1)];
+        m_tail = tail + 1;                // libera la celda ya leída
+        return true;
+    }
+
+    // Consumidor: descarta lo pendiente
+    void clear() { m_tail = m_head; }
+
+    uint32_t size() const { return m_head - m_tail; }
+    uint32_t dropped() const { return m_dropped; }
+    static constexpr uint32_t capacity() { return N; }
+
+private:
+    // volatile también en los datos: el compilador no puede mover la
+    // escritura de la celda después de la del índice
+    volatile uint64_t m_buf[N];
+    volatile uint32_t m_head;     // solo lo escribe el productor
+    volatile uint32_t m_tail;     // solo lo escribe el consumidor
+    volatile uint32_t m_dropped;  // solo lo escribe el productor
+};
+
+class LapStats {
+public:
+    LapStats() { reset(); }
+
+    void reset() {
+        m_count = 0;
+        m_min = 0;
+        m_max = 0;
+        m_mean = 0.0;
+        m_m2 = 0.0;
+    }
+
+    // Welford: actualiza media y suma de cuadrados de las diferencias
+    void add(uint64_t x) {
+        m_count++;
+        if (m_count == 1 || x < m_min) m_min = x;
+        if (m_count == 1 || x > m_max) m_max = x;
+        double delta = (double)x - m_mean;
+        m_mean += delta / (double)m_count;
+        m_m2 += delta * ((double)x - m_mean);
+    }
+
+    uint32_t count() const { return m_count; }
+    uint64_t min() const { return m_min; }
+    uint64_t max() const { return m_max; }
+    double mean() const { return m_mean; }
+
+    // Varianza muestral (n - 1); 0 con menos de dos vueltas
+    double variance() const { return m_count > 1 ? m_m2 / (double)(m_count - 1) : 0.0; }
+    double stddev() const { return sqrt(variance()); }
+
+private:
+    uint32_t m_count;
+    uint64_t m_min;
+    uint64_t m_max;
+    double   m_mean;
+    double   m_m2;
+};
+
+template <uint32_t N>
+class LapRecorder {
+public:
+    struct Lap {
+        uint32_t number;   // 1, 2, ...
+        uint64_t split;    // tiempo total del cronómetro al marcar la vuelta
+        uint64_t lap;      // duración de esta vuelta
+    };
+
+    LapRecorder() : m_lastSplit(0), m_number(0) {}
+
+    // Productor: marca una vuelta con el tiempo del cronómetro en ticks
+    bool split(uint64_t elapsedTicks) { return m_ring.push(elapsedTicks); }
+
+    // Consumidor: saca la siguiente vuelta y la suma a las estadísticas
+    bool poll(Lap& lap) {
+        uint64_t split;
+        if (!m_ring.pop(split)) return false;
+        lap.number = ++m_number;
+        lap.split  = split;
+        lap.lap    = split - m_lastSplit;
+        m_lastSplit = split;
+        m_stats.add(lap.lap);
+        return true;
+    }
+
+    // Consumidor: borra vueltas y estadísticas (junto con Stopwatch::reset())
+    void reset() {
+        m_ring.clear();
+        m_stats.reset();
+        m_lastSplit = 0;
+        m_number = 0;
+    }
+
+    const LapStats& stats() const { return m_stats; }
+    uint32_t count() const { return m_number; }
+    uint32_t dropped() const { return m_ring.dropped(); }
+
+private:
+    SplitRing<N> m_ring;
+    LapStats     m_stats;
+    uint64_t     m_lastSplit;
+    uint32_t     m_number;
+};
+
+#endif // TM4C_LAPS_H
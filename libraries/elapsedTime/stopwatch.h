@@ -0,0 +1,104 @@
+#ifndef TM4C_STOPWATCH_H
+#define TM4C_STOPWATCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timerLib.h"
+
+// Cronómetro basado en los ticks crudos de un Timer
+// Guarda el tiempo acumulado en ticks de reloj, capturados solo en los flancos
+// de start/stop; no suma deltas en el superloop, así que una vuelta lenta del
+// loop (un flush bloqueante, etc.) no le quita ni le añade tiempo. Horas,
+// minutos, segundos y ms se calculan solo al leerlos con time().
+// Uso típico:
+//   Timer t; t.begin(sysclkHz, WTIMER0_BASE);
+//   Stopwatch sw(t);
+//   sw.start();  ...  sw.stop();
+//   Stopwatch::Time hms = sw.time();
+// Con un timer de 32 bits, Timer::ticks() se extiende a 64 bits por
+// interrupción, así que no hay límite práctico de duración con ninguno.
+
+class Stopwatch {
+public:
+    struct Time {
+        uint32_t hours;
+        uint32_t minutes;
+        uint32_t seconds;
+        uint32_t millis;
+    };
+
+    explicit Stopwatch(Timer& timer)
+        : m_timer(&timer), m_accum(0), m_startTick(0), m_running(false) {}
+
+    // Arranca / detiene en el tick actual del Timer
+    void start() { start(m_timer->ticks()); }
+    void stop()  { stop(m_timer->ticks()); }
+
+    // Arranca / detiene en un tick ya capturado (p.ej. leído en la ISR del
+    // botón o en un capture del GPTM), en la misma base que Timer::ticks()
+    void start(uint64_t atTick) {
+        if (m_running) return;
+        m_startTick = atTick;
+        m_running = true;
+    }
+
+    void stop(uint64_t atTick) {
+        if (!m_running) return;
+        m_accum += atTick - m_startTick;
+        m_running = false;
+    }
+
+    void toggle() { if (m_running) stop(); else start(); }
+
+    // Pone el tiempo a cero sin cambiar el estado (si corre, sigue corriendo)
+    void reset() {
+        m_accum = 0;
+        m_startTick = m_timer->ticks();
+    }
+
+    bool isRunning() const { return m_running; }
+
+    // Ticks acumulados, incluido el tramo en curso
+    uint64_t elapsedTicks() const { return elapsedTicksAt(m_timer->ticks()); }
+
+    // Ticks acumulados hasta un tick ya capturado (p.ej. el de un split)
+    uint64_t elapsedTicksAt(uint64_t atTick) const {
+        return m_running ? m_accum + (atTick - m_startTick) : m_accum;
+    }
+
+    uint64_t elapsedMillis() const { return toMillis(elapsedTicks()); }
+
+    // Tiempo transcurrido desglosado (las horas no se limitan)
+    Time time() const { return toTime(elapsedMillis()); }
+
+    // ticks -> ms con el recíproco del Timer (Timer::toMillis), sin división
+    // de 64 bits; exacto con un reloj de MHz enteros, como Timer::millis()
+    uint64_t toMillis(uint64_t ticks) const {
+        if (!m_timer->clockHz()) return 0ull;
+        return m_timer->toMillis(ticks);
+    }
+
+    // ms -> H:M:S:ms sin división de 64 bits: las horas con un Reciprocal
+    // fijo y el resto (< 1 h) en 32 bits por multiplicación y desplazamiento
+    static Time toTime(uint64_t ms) {
+        // Reciprocal::set(3600000), calculado una vez
+        static const Reciprocal kMsPerHour = { 0x2a42f961f79b9594ull, 21, false };
+        Time t;
+        uint64_t hours = kMsPerHour.divide(ms);
+        uint32_t rem = (uint32_t)(ms - hours * 3600000u);          // < 3600000
+        uint32_t s   = (uint32_t)(((uint64_t)rem * 274877907u) >> 38);  // rem / 1000
+        t.hours   = (uint32_t)hours;
+        t.millis  = rem - s * 1000u;
+        t.minutes = (s * 34953u) >> 21;                              // s / 60 (s < 3600)
+        t.seconds = s - t.minutes * 60u;
+        return t;
+    }
+
+private:
+    Timer*   m_timer;       // backend
+    uint64_t m_accum;       // ticks de los tramos ya cerrados
+    uint64_t m_startTick;   // tick del último start()
+    bool     m_running;
+};
+
+#endif // TM4C_STOPWATCH_H
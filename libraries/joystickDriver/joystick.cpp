@@ -1,12 +1,12 @@
 #include "joystick.h"
 
-// Constructor delegates to Button for the push pin
-Joystick::Joystick(uint8_t pinX, uint8_t pinY, uint8_t pinButton,
-                   uint32_t debounceTicks,
-                   uint32_t longPressTicks,
-                   uint32_t doubleClickTicks,
-                   ButtonPull pull)
-    : Button(pinButton, debounceTicks, longPressTicks, doubleClickTicks, pull),
+// Constructor delegates to ButtonCore for the push pin
+JoystickCore::JoystickCore(uint8_t pinX, uint8_t pinY, uint8_t pinButton,
+                           uint32_t debounceTicks,
+                           uint32_t longPressTicks,
+                           uint32_t doubleClickTicks,
+                           ButtonPull pull)
+    : ButtonCore(pinButton, debounceTicks, longPressTicks, doubleClickTicks, pull),
       _pinX(pinX), _pinY(pinY),
       _portX(0), _portY(0),
       _baseX(0), _baseY(0),
@@ -29,7 +29,7 @@ Joystick::Joystick(uint8_t pinX, uint8_t pinY, uint8_t pinButton,
 {
 }
 
-void Joystick::begin() {
+void JoystickCore::begin() {
     // Map pins → port/base/mask and ADC channels
     configureGpioAnalog(_pinX, _portX, _baseX, _maskX);
     configureGpioAnalog(_pinY, _portY, _baseY, _maskY);
@@ -53,31 +53,17 @@ void Joystick::begin() {
     _adcInit = true;
 
     // Initialize Button (push)
-    Button::begin();
+    ButtonCore::begin();
 }
 
-void Joystick::tick() {
-    // Advance software timebase
-    _nowMs += _tickMs;
-
-    if (_adcInit) {
-        readAdc2(_rawX, _rawY);
-        filterAndNormalize();
-        computePolarAndEvents();
-    }
-
-    // Tick the push-button FSM (reads physical via Button logic)
-    Button::tick();
-}
-
-void Joystick::sanitizeRanges() {
+void JoystickCore::sanitizeRanges() {
     if (_minX > _maxX) { uint16_t t = _minX; _minX = _maxX; _maxX = t; }
     if (_minY > _maxY) { uint16_t t = _minY; _minY = _maxY; _maxY = t; }
     if (!(_minX <= _centerX && _centerX <= _maxX)) _centerX = (_minX + _maxX) / 2;
     if (!(_minY <= _centerY && _centerY <= _maxY)) _centerY = (_minY + _maxY) / 2;
 }
 
-void Joystick::configureGpioAnalog(uint8_t pin, uint8_t& port, uint32_t& base, uint8_t& mask) {
+void JoystickCore::configureGpioAnalog(uint8_t pin, uint8_t& port, uint32_t& base, uint8_t& mask) {
     port = digital_pin_to_port[pin];
     base = port_to_base[port];
     mask = digital_pin_to_bit_mask[pin];
@@ -90,7 +76,7 @@ void Joystick::configureGpioAnalog(uint8_t pin, uint8_t& port, uint32_t& base, u
     }
 }
 
-void Joystick::configureAdcSequencer() {
+void JoystickCore::configureAdcSequencer() {
     // Use ADC0, sequence 0 (two steps: X then Y)
     ADCSequenceDisable(_adcBase, _adcSeq);
     ADCSequenceConfigure(_adcBase, _adcSeq, ADC_TRIGGER_PROCESSOR, 0);
@@ -107,7 +93,7 @@ void Joystick::configureAdcSequencer() {
     ADCSequenceEnable(_adcBase, _adcSeq);
 }
 
-void Joystick::readAdc2(uint16_t& x, uint16_t& y) {
+void JoystickCore::readAdc2(uint16_t& x, uint16_t& y) {
     uint32_t tmp[2] = {0};
     ADCProcessorTrigger(_adcBase, _adcSeq);
     while(!ADCIntStatus(_adcBase, _adcSeq, false)) {}
@@ -118,7 +104,7 @@ void Joystick::readAdc2(uint16_t& x, uint16_t& y) {
     if (_swapXY) { x = a1; y = a0; } else { x = a0; y = a1; }
 }
 
-void Joystick::filterAndNormalize() {
+void JoystickCore::filterAndNormalize() {
     // Convert raw → signed normalized around center, per-axis, then IIR
     auto normAxis = [](uint16_t raw, uint16_t minV, uint16_t centerV, uint16_t maxV) -> float {
         if (raw >= centerV) {
@@ -166,7 +152,7 @@ static inline float angle_wrap(float a) {
     return a;
 }
 
-JoystickDir Joystick::quantize8(float ang) const {
+JoystickDir JoystickCore::quantize8(float ang) const {
     // Map angle to sectors centered at N(90°), E(0°), etc. Use atan2(y,x) where 0 = E
     const float PI = 3.14159265358979323846f;
     const float step = (float)PI / 4.0f; // 45°
@@ -187,7 +173,9 @@ JoystickDir Joystick::quantize8(float ang) const {
     }
 }
 
-void Joystick::computePolarAndEvents() {
+uint8_t JoystickCore::computePolarAndEvents() {
+    uint8_t ev = 0;
+
     // Polar values
     _mag = sqrtf(_nx * _nx + _ny * _ny);
     _angle = atan2f(_ny, _nx); // radians, 0 = +X (east)
@@ -204,11 +192,11 @@ void Joystick::computePolarAndEvents() {
 
     // Events: tilt start/stop
     if (tiltNow && !_tiltActive) {
-        emitTiltStart();
+        ev |= JOYSTICK_EV_TILT_START;
         _tiltActive = true;
     } else if (!tiltNow && _tiltActive) {
-        emitTiltStop();
-        emitCenter();
+        ev |= JOYSTICK_EV_TILT_STOP;
+        ev |= JOYSTICK_EV_CENTER;
         _tiltActive = false;
     }
 
@@ -216,24 +204,25 @@ void Joystick::computePolarAndEvents() {
     if (newDir != _dir) {
         _lastDir = _dir;
         _dir = newDir;
-        emitDirChanged();
+        ev |= JOYSTICK_EV_DIRECTION_CHANGED;
         _lastRepeatMs = _nowMs; // reset repeat timer on change
     }
 
     // Move event (epsilon on nx, ny)
     if (fabsf_fast(_nx - _lastNx) >= _moveEps || fabsf_fast(_ny - _lastNy) >= _moveEps) {
-        emitMove();
+        ev |= JOYSTICK_EV_MOVE;
         _lastNx = _nx; _lastNy = _ny;
     }
 
     // Repeat while a direction is active
     if (_dir != JoystickDir::Center && (_nowMs - _lastRepeatMs) >= _repeatMs) {
-        emitRepeat();
+        ev |= JOYSTICK_EV_REPEAT;
         _lastRepeatMs = _nowMs;
     }
+    return ev;
 }
 
-void Joystick::calibrateCenter(uint16_t samples) {
+void JoystickCore::calibrateCenter(uint16_t samples) {
     // Simple blocking center calibration; assumes stick is at rest
     uint32_t accX = 0, accY = 0;
     for (uint16_t i = 0; i < samples; ++i) {
@@ -244,39 +233,49 @@ void Joystick::calibrateCenter(uint16_t samples) {
     _centerY = (uint16_t)(accY / samples);
 }
 
-// Emit helpers: prefer simplified Events (void(Joystick&)) then fallback to legacy attach API
-inline void Joystick::emitMove() {
-    if (_events.move) { _events.move(*this); return; }
-    if (_onMove) _onMove();
-    if (_onMoveP) _onMoveP(_onMoveParam);
-}
-
-inline void Joystick::emitTiltStart() {
-    if (_events.tiltStart) { _events.tiltStart(*this); return; }
-    if (_onTiltStart) _onTiltStart();
-    if (_onTiltStartP) _onTiltStartP(_onTiltStartParam);
-}
-
-inline void Joystick::emitTiltStop() {
-    if (_events.tiltStop) { _events.tiltStop(*this); return; }
-    if (_onTiltStop) _onTiltStop();
-    if (_onTiltStopP) _onTiltStopP(_onTiltStopParam);
-}
-
-inline void Joystick::emitDirChanged() {
-    if (_events.directionChanged) { _events.directionChanged(*this); return; }
-    if (_onDirChanged) _onDirChanged();
-    if (_onDirChangedP) _onDirChangedP(_onDirChangedParam);
-}
-
-inline void Joystick::emitRepeat() {
-    if (_events.repeat) { _events.repeat(*this); return; }
-    if (_onRepeat) _onRepeat();
-    if (_onRepeatP) _onRepeatP(_onRepeatParam);
-}
-
-inline void Joystick::emitCenter() {
-    if (_events.center) { _events.center(*this); return; }
-    if (_onCenter) _onCenter();
-    if (_onCenterP) _onCenterP(_onCenterParam);
+// Dispatch stick events: prefer simplified Events (void(Joystick&)) then fallback to legacy attach API
+void Joystick::dispatchStick(uint8_t ev) {
+    if (!ev) return;
+    if (ev & JOYSTICK_EV_TILT_START) {
+        if (_events.tiltStart) { _events.tiltStart(*this); }
+        else {
+            if (_onTiltStart) _onTiltStart();
+            if (_onTiltStartP) _onTiltStartP(_onTiltStartParam);
+        }
+    }
+    if (ev & JOYSTICK_EV_TILT_STOP) {
+        if (_events.tiltStop) { _events.tiltStop(*this); }
+        else {
+            if (_onTiltStop) _onTiltStop();
+            if (_onTiltStopP) _onTiltStopP(_onTiltStopParam);
+        }
+    }
+    if (ev & JOYSTICK_EV_CENTER) {
+        if (_events.center) { _events.center(*this); }
+        else {
+            if (_onCenter) _onCenter();
+            if (_onCenterP) _onCenterP(_onCenterParam);
+        }
+    }
+    if (ev & JOYSTICK_EV_DIRECTION_CHANGED) {
+        if (_events.directionChanged) { _events.directionChanged(*this); }
+        else {
+            if (_onDirChanged) _onDirChanged();
+            if (_onDirChangedP) _onDirChangedP(_onDirChangedParam);
+        }
+    }
+    if (ev & JOYSTICK_EV_MOVE) {
+        if (_events.move) { _events.move(*this); }
+        else {
+            if (_onMove) _onMove();
+            if (_onMoveP) _onMoveP(_onMoveParam);
+        }
+    }
+    if (ev & JOYSTICK_EV_REPEAT) {
+        if (_events.repeat) { _events.repeat(*this); }
+        else {
+            if (_onRepeat) _onRepeat();
+            if (_onRepeatP) _onRepeatP(_onRepeatParam);
+        }
+    }
 }
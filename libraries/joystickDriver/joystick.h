@@ -18,26 +18,37 @@ enum class JoystickDir : uint8_t {
     N, NE, E, SE, S, SW, W, NW
 };
 
-class Joystick : public Button {
-public:
-    // Callback types (mirroring Button style)
-    typedef void (*callbackFunction)(void);
-    typedef void (*parameterizedCallbackFunction)(void*);
+// Stick events of one tick, as bits. Several in the same tick fire in bit order.
+enum JoystickEventBit : uint8_t {
+    JOYSTICK_EV_TILT_START        = 1u << 0,
+    JOYSTICK_EV_TILT_STOP         = 1u << 1,
+    JOYSTICK_EV_CENTER            = 1u << 2,
+    JOYSTICK_EV_DIRECTION_CHANGED = 1u << 3,
+    JOYSTICK_EV_MOVE              = 1u << 4,
+    JOYSTICK_EV_REPEAT            = 1u << 5,
+};
 
+// Stick + push-button logic without callbacks. Used by:
+// - Joystick: runtime callbacks (Events, on*/attach*), as before.
+// - JoystickT<Derived>: handlers bound at compile time (CRTP); events without
+//   a handler cost no RAM and no branches.
+class JoystickCore : public ButtonCore {
+public:
     // Constructor: pins are Energia-style IDs from pins.h (e.g., PD_2, PK_1)
-    Joystick(uint8_t pinX,
-             uint8_t pinY,
-             uint8_t pinButton,
-             uint32_t debounceTicks = 3,
-             uint32_t longPressTicks = 50,
-             uint32_t doubleClickTicks = 25,
-             ButtonPull pull = ButtonPull::PullUp);
+    JoystickCore(uint8_t pinX,
+                 uint8_t pinY,
+                 uint8_t pinButton,
+                 uint32_t debounceTicks = 3,
+                 uint32_t longPressTicks = 50,
+                 uint32_t doubleClickTicks = 25,
+                 ButtonPull pull = ButtonPull::PullUp);
 
     // Lifecycle
     void begin();
 
-    // Polling (call periodically at ~tickIntervalMs)
-    void tick();
+    // Polling (call periodically at ~tickIntervalMs): stick events go to
+    // sink.dispatchStick(mask), push-button events to sink.dispatch(mask)
+    template <class Sink> void tick(Sink& sink);
 
     // Raw readings (12-bit ADC)
     uint16_t rawX() const { return _rawX; }
@@ -71,48 +82,7 @@ public:
 
     void setMoveEpsilon(float eps) { _moveEps = (eps < 0.0f ? 0.0f : eps); }
     void setRepeatIntervalMs(uint32_t ms) { _repeatMs = ms; }
-    void setTickIntervalMs(uint32_t ms) { _tickMs = (ms == 0 ? 1u : ms); Button::setTickIntervalMs(_tickMs); }
-
-    // Simplified event API: register all at once
-    struct Events {
-        void (*move)(Joystick&) = nullptr;
-        void (*tiltStart)(Joystick&) = nullptr;
-        void (*tiltStop)(Joystick&) = nullptr;
-        void (*directionChanged)(Joystick&) = nullptr;
-        void (*repeat)(Joystick&) = nullptr;
-        void (*center)(Joystick&) = nullptr;
-    };
-
-    void setEvents(const Events& e) { _events = e; }
-
-    // Chainable helpers (fluent style)
-    Joystick& onMove(void (*fn)(Joystick&)) { _events.move = fn; return *this; }
-    Joystick& onTiltStart(void (*fn)(Joystick&)) { _events.tiltStart = fn; return *this; }
-    Joystick& onTiltStop(void (*fn)(Joystick&)) { _events.tiltStop = fn; return *this; }
-    Joystick& onDirectionChanged(void (*fn)(Joystick&)) { _events.directionChanged = fn; return *this; }
-    Joystick& onRepeat(void (*fn)(Joystick&)) { _events.repeat = fn; return *this; }
-    Joystick& onCenter(void (*fn)(Joystick&)) { _events.center = fn; return *this; }
-
-    // Legacy-style registration (kept for compatibility)
-    // Prefer the simplified API above when possible.
-    // Event registration
-    void attachMove(callbackFunction fn) { _onMove = fn; }
-    void attachMove(parameterizedCallbackFunction fn, void* p) { _onMoveP = fn; _onMoveParam = p; }
-
-    void attachTiltStart(callbackFunction fn) { _onTiltStart = fn; }
-    void attachTiltStart(parameterizedCallbackFunction fn, void* p) { _onTiltStartP = fn; _onTiltStartParam = p; }
-
-    void attachTiltStop(callbackFunction fn) { _onTiltStop = fn; }
-    void attachTiltStop(parameterizedCallbackFunction fn, void* p) { _onTiltStopP = fn; _onTiltStopParam = p; }
-
-    void attachDirectionChanged(callbackFunction fn) { _onDirChanged = fn; }
-    void attachDirectionChanged(parameterizedCallbackFunction fn, void* p) { _onDirChangedP = fn; _onDirChangedParam = p; }
-
-    void attachRepeat(callbackFunction fn) { _onRepeat = fn; }
-    void attachRepeat(parameterizedCallbackFunction fn, void* p) { _onRepeatP = fn; _onRepeatParam = p; }
-
-    void attachCenter(callbackFunction fn) { _onCenter = fn; }
-    void attachCenter(parameterizedCallbackFunction fn, void* p) { _onCenterP = fn; _onCenterParam = p; }
+    void setTickIntervalMs(uint32_t ms) { _tickMs = (ms == 0 ? 1u : ms); ButtonCore::setTickIntervalMs(_tickMs); }
 
 private:
     // Pin/port/channel mapping
@@ -163,6 +133,106 @@ private:
     bool  _tiltActive;
     bool  _swapXY = false;     // if true, swap axis assignment (diagnostic/hw variant)
 
+    // Helpers
+    static inline float clamp01(float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+    static inline float fabsf_fast(float v) { return v >= 0.0f ? v : -v; }
+
+    void sanitizeRanges();
+    void configureGpioAnalog(uint8_t pin, uint8_t& port, uint32_t& base, uint8_t& mask);
+    void configureAdcSequencer();
+
+    void readAdc2(uint16_t& x, uint16_t& y);
+    
+public:
+    // Diagnostics/variants: swap XY assignment if board wiring differs
+    void setSwapXY(bool en) { _swapXY = en; }
+    void filterAndNormalize();
+    uint8_t computePolarAndEvents();   // returns JoystickEventBit mask
+    JoystickDir quantize8(float angleRad) const;
+};
+
+template <class Sink>
+void JoystickCore::tick(Sink& sink) {
+    // Advance software timebase
+    _nowMs += _tickMs;
+
+    if (_adcInit) {
+        readAdc2(_rawX, _rawY);
+        filterAndNormalize();
+        sink.dispatchStick(computePolarAndEvents());
+    }
+
+    // Tick the push-button FSM (reads physical via Button logic)
+    ButtonCore::tick(sink);
+}
+
+// Joystick with runtime callbacks (original API)
+class Joystick : public JoystickCore, public ButtonCallbacks<Joystick> {
+public:
+    // Callback types (mirroring Button style)
+    typedef void (*callbackFunction)(void);
+    typedef void (*parameterizedCallbackFunction)(void*);
+
+    Joystick(uint8_t pinX,
+             uint8_t pinY,
+             uint8_t pinButton,
+             uint32_t debounceTicks = 3,
+             uint32_t longPressTicks = 50,
+             uint32_t doubleClickTicks = 25,
+             ButtonPull pull = ButtonPull::PullUp)
+        : JoystickCore(pinX, pinY, pinButton, debounceTicks, longPressTicks, doubleClickTicks, pull) {}
+
+    // Polling (call periodically at ~tickIntervalMs)
+    void tick() { JoystickCore::tick(*this); }
+
+    // Simplified event API: register all at once
+    struct Events {
+        void (*move)(Joystick&) = nullptr;
+        void (*tiltStart)(Joystick&) = nullptr;
+        void (*tiltStop)(Joystick&) = nullptr;
+        void (*directionChanged)(Joystick&) = nullptr;
+        void (*repeat)(Joystick&) = nullptr;
+        void (*center)(Joystick&) = nullptr;
+    };
+
+    void setEvents(const Events& e) { _events = e; }
+
+    // Chainable helpers (fluent style)
+    Joystick& onMove(void (*fn)(Joystick&)) { _events.move = fn; return *this; }
+    Joystick& onTiltStart(void (*fn)(Joystick&)) { _events.tiltStart = fn; return *this; }
+    Joystick& onTiltStop(void (*fn)(Joystick&)) { _events.tiltStop = fn; return *this; }
+    Joystick& onDirectionChanged(void (*fn)(Joystick&)) { _events.directionChanged = fn; return *this; }
+    Joystick& onRepeat(void (*fn)(Joystick&)) { _events.repeat = fn; return *this; }
+    Joystick& onCenter(void (*fn)(Joystick&)) { _events.center = fn; return *this; }
+
+    // Legacy-style registration (kept for compatibility)
+    // Prefer the simplified API above when possible.
+    // Event registration
+    void attachMove(callbackFunction fn) { _onMove = fn; }
+    void attachMove(parameterizedCallbackFunction fn, void* p) { _onMoveP = fn; _onMoveParam = p; }
+
+    void attachTiltStart(callbackFunction fn) { _onTiltStart = fn; }
+    void attachTiltStart(parameterizedCallbackFunction fn, void* p) { _onTiltStartP = fn; _onTiltStartParam = p; }
+
+    void attachTiltStop(callbackFunction fn) { _onTiltStop = fn; }
+    void attachTiltStop(parameterizedCallbackFunction fn, void* p) { _onTiltStopP = fn; _onTiltStopParam = p; }
+
+    void attachDirectionChanged(callbackFunction fn) { _onDirChanged = fn; }
+    void attachDirectionChanged(parameterizedCallbackFunction fn, void* p) { _onDirChangedP = fn; _onDirChangedParam = p; }
+
+    void attachRepeat(callbackFunction fn) { _onRepeat = fn; }
+    void attachRepeat(parameterizedCallbackFunction fn, void* p) { _onRepeatP = fn; _onRepeatParam = p; }
+
+    void attachCenter(callbackFunction fn) { _onCenter = fn; }
+    void attachCenter(parameterizedCallbackFunction fn, void* p) { _onCenterP = fn; _onCenterParam = p; }
+
+    // Internal: called by JoystickCore::tick() with the stick events of a tick
+    void dispatchStick(uint8_t ev);
+
+    // New event storage (preferred)
+    Events _events;
+
+private:
     // Events
     callbackFunction _onMove = nullptr;
     parameterizedCallbackFunction _onMoveP = nullptr; void* _onMoveParam = nullptr;
@@ -181,32 +251,60 @@ private:
 
     callbackFunction _onCenter = nullptr;
     parameterizedCallbackFunction _onCenterP = nullptr; void* _onCenterParam = nullptr;
+};
 
-    // Helpers
-    static inline float clamp01(float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
-    static inline float fabsf_fast(float v) { return v >= 0.0f ? v : -v; }
-
-    void sanitizeRanges();
-    void configureGpioAnalog(uint8_t pin, uint8_t& port, uint32_t& base, uint8_t& mask);
-    void configureAdcSequencer();
-
-    void readAdc2(uint16_t& x, uint16_t& y);
-    
+// Joystick with handlers bound at compile time (CRTP). Derived hides the
+// on*() it needs (stick and push-button); the rest stay empty and compile away.
+//   struct Cursor : JoystickT<Cursor> {
+//       using JoystickT::JoystickT;
+//       void onDirectionChanged() { moveCursor(direction8()); }
+//       void onClick() { select(); }
+//   };
+template <class Derived>
+class JoystickT : public JoystickCore {
 public:
-    // Diagnostics/variants: swap XY assignment if board wiring differs
-    void setSwapXY(bool en) { _swapXY = en; }
-    void filterAndNormalize();
-    void computePolarAndEvents();
-    JoystickDir quantize8(float angleRad) const;
-    inline void emitMove();
-    inline void emitTiltStart();
-    inline void emitTiltStop();
-    inline void emitDirChanged();
-    inline void emitRepeat();
-    inline void emitCenter();
-
-    // New event storage (preferred)
-    Events _events;
+    JoystickT(uint8_t pinX,
+              uint8_t pinY,
+              uint8_t pinButton,
+              uint32_t debounceTicks = 3,
+              uint32_t longPressTicks = 50,
+              uint32_t doubleClickTicks = 25,
+              ButtonPull pull = ButtonPull::PullUp)
+        : JoystickCore(pinX, pinY, pinButton, debounceTicks, longPressTicks, doubleClickTicks, pull) {
+        if (!std::is_same<decltype(&Derived::onMultiClick), void (JoystickT::*)()>::value) setMaxClicks(100);
+    }
+
+    void tick() { JoystickCore::tick(*this); }
+
+    // Default handlers: do nothing
+    void onTiltStart() {}
+    void onTiltStop() {}
+    void onCenter() {}
+    void onDirectionChanged() {}
+    void onMove() {}
+    void onRepeat() {}
+
+    void onIdle() {}
+    void onPress() {}
+    void onRelease() {}
+    void onLongPressStart() {}
+    void onDuringLongPress() {}
+    void onClick() {}
+    void onDoubleClick() {}
+    void onMultiClick() {}
+    void onLongPressStop() {}
+
+    // Internal: called by JoystickCore::tick()
+    void dispatchStick(uint8_t ev) {
+        Derived& d = static_cast<Derived&>(*this);
+        if (ev & JOYSTICK_EV_TILT_START)        d.onTiltStart();
+        if (ev & JOYSTICK_EV_TILT_STOP)         d.onTiltStop();
+        if (ev & JOYSTICK_EV_CENTER)            d.onCenter();
+        if (ev & JOYSTICK_EV_DIRECTION_CHANGED) d.onDirectionChanged();
+        if (ev & JOYSTICK_EV_MOVE)              d.onMove();
+        if (ev & JOYSTICK_EV_REPEAT)            d.onRepeat();
+    }
+    void dispatch(uint16_t ev) { dispatchButtonEvents(static_cast<Derived&>(*this), ev); }
 };
 
 #endif // JOYSTICK_H
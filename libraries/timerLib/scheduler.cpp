@@ -0,0 +1,191 @@
+#include "scheduler.h"
+
+Scheduler::Scheduler(Timer& timer)
+: m_timer(&timer),
+  m_heapSize(0)
+{
+    for (uint8_t i = 0; i < MAX_TASKS; ++i) {
+        m_tasks[i].used = false;
+        m_tasks[i].inHeap = false;
+    }
+    resetStats();
+}
+
+Scheduler::TaskId Scheduler::every(uint32_t periodMs, TaskFunction fn, uint8_t priority)
+{
+    if (periodMs == 0) return -1;
+    uint64_t period = msToTicks(periodMs);
+    return add(period, period, fn, priority);
+}
+
+Scheduler::TaskId Scheduler::after(uint32_t delayMs, TaskFunction fn, uint8_t priority)
+{
+    return add(msToTicks(delayMs), 0, fn, priority);
+}
+
+Scheduler::TaskId Scheduler::add(uint64_t delay, uint64_t period, TaskFunction fn, uint8_t priority)
+{
+    if (!fn) return -1;
+
+    for (uint8_t i = 0; i < MAX_TASKS; ++i) {
+        Task& t = m_tasks[i];
+        if (t.used) continue;
+
+        t.fn       = fn;
+        t.deadline = m_timer->ticks() + delay;
+        t.period   = period;
+        t.priority = priority;
+        t.used     = true;
+        t.stats    = TaskStats();
+        heapPush((TaskId)i);
+        return (TaskId)i;
+    }
+    return -1;
+}
+
+bool Scheduler::cancel(TaskId id)
+{
+    if (id < 0 || id >= (TaskId)MAX_TASKS || !m_tasks[id].used) return false;
+
+    if (m_tasks[id].inHeap) {
+        for (uint8_t pos = 0; pos < m_heapSize; ++pos) {
+            if (m_heap[pos] == id) { heapRemoveAt(pos); break; }
+        }
+    }
+    m_tasks[id].used = false;
+    return true;
+}
+
+uint32_t Scheduler::run()
+{
+    if (m_heapSize == 0) return 0;
+
+    // Única lectura del timer para decidir qué está vencido
+    uint64_t now = m_timer->ticks();
+    if (m_tasks[m_heap[0]].deadline > now) return 0;
+
+    // Saca las vencidas, ordenadas por prioridad (a igual prioridad, por plazo)
+    TaskId due[MAX_TASKS];
+    uint8_t n = 0;
+    while (m_heapSize && m_tasks[m_heap[0]].deadline <= now) {
+        TaskId id = heapPop();
+        uint8_t i = n++;
+        while (i > 0 && m_tasks[due[i - 1]].priority < m_tasks[id].priority) {
+            due[i] = due[i - 1];
+            --i;
+        }
+        due[i] = id;
+    }
+
+    uint32_t ran = 0;
+    uint64_t start = now;
+    for (uint8_t i = 0; i < n; ++i) {
+        TaskId id = due[i];
+        Task& t = m_tasks[id];
+        // Cancelada (o hueco reutilizado) por una tarea anterior de esta pasada
+        if (!t.used || t.inHeap) continue;
+
+        t.fn();
+        uint64_t end = m_timer->ticks();
+        ++ran;
+
+        // Se canceló y add() reutilizó el hueco (ya está en el heap): es otra
+        // tarea, que no se cobra ni se reprograma
+        if (t.inHeap) {
+            start = end;
+            continue;
+        }
+
+        // El fin de una tarea es el arranque de la siguiente: una lectura por tarea
+        TaskStats& s = t.stats;
+        uint32_t jitter = (uint32_t)(start - t.deadline);
+        uint32_t dur    = (uint32_t)(end - start);
+        s.runs++;
+        s.lastRun = dur;
+        if (dur > s.maxRun) s.maxRun = dur;
+        s.totalRun += dur;
+        s.lastJitter = jitter;
+        if (jitter > s.maxJitter) s.maxJitter = jitter;
+        start = end;
+
+        if (!t.used) continue;          // se canceló a sí misma
+        if (t.period == 0) {            // una sola vez: libera el hueco
+            t.used = false;
+            continue;
+        }
+
+        // Siguiente plazo sobre el anterior (sin deriva); si ya pasó, salta
+        // los periodos perdidos en vez de ejecutarlos en ráfaga
+        t.deadline += t.period;
+        if (t.deadline <= end) {
+            uint64_t skip = (end - t.deadline) / t.period + 1;
+            t.deadline += skip * t.period;
+            s.missed += (uint32_t)skip;
+        }
+        heapPush(id);
+    }
+    return ran;
+}
+
+uint64_t Scheduler::nextDeadline() const
+{
+    return m_heapSize ? m_tasks[m_heap[0]].deadline : UINT64_MAX;
+}
+
+void Scheduler::resetStats()
+{
+    for (uint8_t i = 0; i < MAX_TASKS; ++i) {
+        m_tasks[i].stats = TaskStats();
+    }
+}
+
+// ---------------------------------------------------------------------------
+// min-heap por deadline
+// ---------------------------------------------------------------------------
+void Scheduler::heapPush(TaskId id)
+{
+    m_heap[m_heapSize] = id;
+    m_tasks[id].inHeap = true;
+    siftUp(m_heapSize++);
+}
+
+Scheduler::TaskId Scheduler::heapPop()
+{
+    TaskId id = m_heap[0];
+    heapRemoveAt(0);
+    return id;
+}
+
+void Scheduler::heapRemoveAt(uint8_t pos)
+{
+    m_tasks[m_heap[pos]].inHeap = false;
+    m_heap[pos] = m_heap[--m_heapSize];
+    if (pos < m_heapSize) {
+        siftDown(pos);
+        siftUp(pos);
+    }
+}
+
+void Scheduler::siftUp(uint8_t pos)
+{
+    while (pos > 0) {
+        uint8_t parent = (uint8_t)((pos - 1) / 2);
+        if (!before(pos, parent)) break;
+        TaskId tmp = m_heap[pos]; m_heap[pos] = m_heap[parent]; m_heap[parent] = tmp;
+        pos = parent;
+    }
+}
+
+void Scheduler::siftDown(uint8_t pos)
+{
+    for (;;) {
+        uint8_t left  = (uint8_t)(2 * pos + 1);
+        uint8_t right = (uint8_t)(left + 1);
+        uint8_t min   = pos;
+        if (left < m_heapSize && before(left, min)) min = left;
+        if (right < m_heapSize && before(right, min)) min = right;
+        if (min == pos) break;
+        TaskId tmp = m_heap[pos]; m_heap[pos] = m_heap[min]; m_heap[min] = tmp;
+        pos = min;
+    }
+}
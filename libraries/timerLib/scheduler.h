@@ -0,0 +1,98 @@
+#ifndef TM4C_SCHEDULER_H
+#define TM4C_SCHEDULER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timerLib.h"
+
+/**
+ * Planificador cooperativo por plazos sobre Timer.
+ * Las tareas (periódicas o de una sola vez) se guardan en un min-heap
+ * ordenado por su próximo plazo en ticks. run() lee el timer una vez, saca
+ * del heap todas las tareas vencidas y las ejecuta por prioridad; no hay
+ * divisiones en el camino normal (los periodos se pasan a ticks al crear
+ * la tarea). Cada tarea lleva su tiempo de ejecución y su retraso (jitter)
+ * respecto al plazo.
+ * Uso típico:
+ *   Scheduler sched(timer);
+ *   sched.every(20, pollButtons, 2);
+ *   sched.every(16, redraw);
+ *   while (true) sched.run();
+ */
+class Scheduler {
+public:
+    typedef void (*TaskFunction)(void);
+    typedef int8_t TaskId;                 // -1 = inválido
+
+    static constexpr uint8_t MAX_TASKS = 16;
+
+    /** Estadísticas por tarea, en ticks del Timer. */
+    struct TaskStats {
+        uint32_t runs;          // ejecuciones
+        uint32_t lastRun;       // duración de la última ejecución
+        uint32_t maxRun;        // duración máxima
+        uint64_t totalRun;      // suma de duraciones (media = totalRun / runs)
+        uint32_t lastJitter;    // retraso del último arranque respecto al plazo
+        uint32_t maxJitter;     // retraso máximo
+        uint32_t missed;        // periodos saltados por retraso (solo periódicas)
+    };
+
+    explicit Scheduler(Timer& timer);
+
+    /**
+     * @brief Tarea periódica. La primera ejecución es un periodo después.
+     * @param periodMs  Periodo en ms (> 0).
+     * @param fn        Función a llamar.
+     * @param priority  Entre tareas vencidas en la misma pasada, mayor primero.
+     * @return id de la tarea, o -1 si no hay hueco.
+     */
+    TaskId every(uint32_t periodMs, TaskFunction fn, uint8_t priority = 0);
+
+    /** Tarea de una sola vez, dentro de delayMs. Libera su hueco al ejecutarse. */
+    TaskId after(uint32_t delayMs, TaskFunction fn, uint8_t priority = 0);
+
+    /** Quita una tarea pendiente. */
+    bool cancel(TaskId id);
+
+    /** Una pasada: ejecuta lo vencido. Devuelve el número de tareas ejecutadas. */
+    uint32_t run();
+
+    /** Plazo más próximo en ticks del Timer (UINT64_MAX si no hay tareas). */
+    uint64_t nextDeadline() const;
+
+    const TaskStats& stats(TaskId id) const { return m_tasks[id].stats; }
+    void resetStats();
+
+    /** ms -> ticks del Timer (solo al crear tareas). */
+    uint64_t msToTicks(uint32_t ms) const { return (uint64_t)ms * (m_timer->clockHz() / 1000u); }
+
+private:
+    struct Task {
+        TaskFunction fn;
+        uint64_t     deadline;   // próximo plazo (ticks)
+        uint64_t     period;     // 0 = una sola vez
+        uint8_t      priority;
+        bool         used;
+        bool         inHeap;     // false mientras se ejecuta en run()
+        TaskStats    stats;
+    };
+
+    TaskId add(uint64_t delay, uint64_t period, TaskFunction fn, uint8_t priority);
+
+    // min-heap de ids ordenado por deadline
+    void heapPush(TaskId id);
+    TaskId heapPop();
+    void heapRemoveAt(uint8_t pos);
+    void siftUp(uint8_t pos);
+    void siftDown(uint8_t pos);
+    bool before(uint8_t a, uint8_t b) const {
+        return m_tasks[m_heap[a]].deadline < m_tasks[m_heap[b]].deadline;
+    }
+
+    Timer*   m_timer;
+    Task     m_tasks[MAX_TASKS];
+    TaskId   m_heap[MAX_TASKS];
+    uint8_t  m_heapSize;
+};
+
+#endif // TM4C_SCHEDULER_H
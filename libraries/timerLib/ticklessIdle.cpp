@@ -0,0 +1,102 @@
+#include "ticklessIdle.h"
+
+extern "C" {
+  #include "driverlib/interrupt.h"
+  #include "driverlib/sysctl.h"
+  #include "driverlib/timer.h"
+  #include "inc/hw_memmap.h"
+}
+
+// Base del wake timer para la ISR (una sola instancia)
+static uint32_t s_wakeBase;
+
+static void wakeIntHandler(void)
+{
+    // Solo despierta a la CPU; el plazo lo atiende el loop
+    TimerIntClear(s_wakeBase, TIMER_TIMA_TIMEOUT);
+}
+
+TicklessIdle::TicklessIdle(Timer& clock)
+: m_clock(&clock),
+  m_base(0),
+  m_statsStart(0)
+{
+    m_stats = Stats();
+}
+
+bool TicklessIdle::begin(uint32_t wakeTimerBase)
+{
+    if (Timer::isWideBase(wakeTimerBase) || wakeTimerBase == m_clock->base()) return false;
+    // El reloj tiene que seguir contando con el núcleo dormido: un GPTM, o
+    // MANUAL, que avanza quien simule el reposo (pruebas). DWT se para.
+    if (!m_clock->isGptm() && m_clock->base() != Timer::MANUAL) return false;
+    if (!Timer::enablePeripheralForBase(wakeTimerBase)) return false;
+
+    m_base = wakeTimerBase;
+    s_wakeBase = wakeTimerBase;
+
+    // 32-bit one-shot, down-counter, reloj del sistema
+    TimerDisable(m_base, TIMER_BOTH);
+    TimerClockSourceSet(m_base, TIMER_CLOCK_SYSTEM);
+    TimerConfigure(m_base, TIMER_CFG_ONE_SHOT);
+    TimerIntClear(m_base, TIMER_TIMA_TIMEOUT);
+    TimerIntRegister(m_base, TIMER_A, wakeIntHandler);   // también la habilita en el NVIC
+    TimerIntEnable(m_base, TIMER_TIMA_TIMEOUT);
+
+    resetStats();
+    return true;
+}
+
+void TicklessIdle::sleepUntil(uint64_t deadline)
+{
+    if (!m_base) return;
+
+    // Con PRIMASK activo una interrupción que llegue entre la comprobación y
+    // el WFI queda pendiente y el WFI vuelve enseguida: no se pierde
+    bool wasDisabled = IntMasterDisable();
+
+    uint64_t start = m_clock->ticks();
+    if (deadline <= start + MIN_SLEEP_TICKS) {
+        if (!wasDisabled) IntMasterEnable();
+        return;
+    }
+    uint64_t delta = deadline - start;
+    if (delta > 0xFFFFFFFFull) delta = 0xFFFFFFFFull;
+
+    TimerLoadSet(m_base, TIMER_A, (uint32_t)delta);
+    TimerEnable(m_base, TIMER_A);
+
+    SysCtlSleep();                       // WFI
+
+    uint64_t end = m_clock->ticks();
+    bool byTimer = (TimerIntStatus(m_base, false) & TIMER_TIMA_TIMEOUT) != 0;
+    TimerDisable(m_base, TIMER_A);
+    TimerIntClear(m_base, TIMER_TIMA_TIMEOUT);
+
+    if (!wasDisabled) IntMasterEnable(); // aquí corre la ISR que despertó
+
+    m_stats.sleeps++;
+    m_stats.sleepTicks += end - start;
+    if (byTimer) {
+        uint32_t latency = end > deadline ? (uint32_t)(end - deadline) : 0;
+        m_stats.timerWakes++;
+        m_stats.lastLatency = latency;
+        if (latency > m_stats.maxLatency) m_stats.maxLatency = latency;
+    } else {
+        m_stats.otherWakes++;
+    }
+}
+
+uint32_t TicklessIdle::dutyCyclePermille() const
+{
+    uint64_t total = m_clock->ticks() - m_statsStart;
+    if (total == 0) return 1000;
+    uint64_t awake = total > m_stats.sleepTicks ? total - m_stats.sleepTicks : 0;
+    return (uint32_t)(awake * 1000u / total);
+}
+
+void TicklessIdle::resetStats()
+{
+    m_stats = Stats();
+    m_statsStart = m_clock->ticks();
+}
@@ -0,0 +1,70 @@
+#ifndef TM4C_TICKLESS_IDLE_H
+#define TM4C_TICKLESS_IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "timerLib.h"
+
+/**
+ * Reposo sin tick: en vez de girar en el loop, duerme (WFI) hasta el
+ * próximo plazo. Un GPTM de 32 bits en one-shot, cargado con los ticks que
+ * faltan, despierta a la CPU; cualquier otra interrupción (flanco de GPIO,
+ * fin de DMA del display, ...) también la despierta antes.
+ * El wake timer y el Timer de referencia cuentan ambos a sysclk. El Timer
+ * de referencia es un GPTM, o Timer::MANUAL en pruebas (el stub de
+ * SysCtlSleep() hace advance() del tiempo dormido); DWT_CYCCNT no sirve.
+ * Uso típico:
+ *   TicklessIdle idle(timer);
+ *   idle.begin(TIMER1_BASE);
+ *   while (true) {
+ *       if (!sched.run()) idle.sleepUntil(sched.nextDeadline());
+ *   }
+ * Los periféricos siguen con reloj durante el reposo (clock gating de
+ * sleep deshabilitado, el valor por defecto).
+ */
+class TicklessIdle {
+public:
+    /** Contadores de instrumentación, en ticks del Timer. */
+    struct Stats {
+        uint32_t sleeps;        // veces que durmió
+        uint32_t timerWakes;    // despertó el wake timer (plazo cumplido)
+        uint32_t otherWakes;    // despertó otra interrupción antes del plazo
+        uint64_t sleepTicks;    // tiempo total dormido
+        uint32_t lastLatency;   // retraso del último despertar por plazo
+        uint32_t maxLatency;    // retraso máximo
+    };
+
+    /** No duerme si faltan menos ticks que esto (~2 us a 120 MHz). */
+    static constexpr uint32_t MIN_SLEEP_TICKS = 240;
+
+    explicit TicklessIdle(Timer& clock);
+
+    /**
+     * @brief Configura el wake timer y registra su interrupción.
+     * @param wakeTimerBase TIMERx_BASE (32-bit) libre, distinto del Timer.
+     * @return true si se pudo inicializar.
+     */
+    bool begin(uint32_t wakeTimerBase);
+
+    /**
+     * @brief Duerme hasta el tick 'deadline' del Timer o hasta otra interrupción.
+     * Vuelve enseguida si el plazo ya pasó o está a menos de MIN_SLEEP_TICKS.
+     * Plazos a más de 2^32 ticks (~35 s a 120 MHz) se recortan.
+     */
+    void sleepUntil(uint64_t deadline);
+
+    const Stats& stats() const { return m_stats; }
+
+    /** Porcentaje de tiempo despierto desde resetStats(), en milésimas. */
+    uint32_t dutyCyclePermille() const;
+
+    void resetStats();
+
+private:
+    Timer*   m_clock;
+    uint32_t m_base;
+    uint64_t m_statsStart;     // tick del último resetStats()
+    Stats    m_stats;
+};
+
+#endif // TM4C_TICKLESS_IDLE_H
@@ -1,6 +1,7 @@
 #include "timerLib.h"
 
 extern "C" {
+  #include "driverlib/interrupt.h"
   #include "driverlib/sysctl.h"
   #include "driverlib/timer.h"
   #include "inc/hw_memmap.h"
@@ -9,12 +10,45 @@ extern "C" {
 
 Timer::Timer()
 : m_base(0),
-  m_isWide(false),
+  m_source(SOURCE_NONE),
   m_sysclkHz(0),
   m_ticksPerUs(0),
-  m_start32(0),
-  m_start64(0)
-{}
+  m_start64(0),
+  m_high(0),
+  m_lastCycles(0),
+  m_manual(0)
+{
+    m_usDiv.set(1);
+    m_msDiv.set(1);
+}
+
+// Registros de depuración del Cortex-M4 para el contador de ciclos
+#define DEMCR            0xE000EDFC      // Debug Exception and Monitor Control
+#define DEMCR_TRCENA     0x01000000      // habilita DWT/ITM
+#define DWT_CTRL         0xE0001000
+#define DWT_CTRL_CYCCNTENA 0x00000001
+
+// Timers de 32-bit con ISR de timeout registrada, por índice TIMER0..TIMER5
+static Timer* s_overflowTimers[6];
+
+template <uint8_t I>
+static void overflowIntHandler(void)
+{
+    if (s_overflowTimers[I]) s_overflowTimers[I]->overflowIsr();
+}
+
+static bool registerOverflowIsr(uint32_t base, Timer* timer)
+{
+    switch (base) {
+        case TIMER0_BASE: s_overflowTimers[0] = timer; TimerIntRegister(base, TIMER_A, overflowIntHandler<0>); return true;
+        case TIMER1_BASE: s_overflowTimers[1] = timer; TimerIntRegister(base, TIMER_A, overflowIntHandler<1>); return true;
+        case TIMER2_BASE: s_overflowTimers[2] = timer; TimerIntRegister(base, TIMER_A, overflowIntHandler<2>); return true;
+        case TIMER3_BASE: s_overflowTimers[3] = timer; TimerIntRegister(base, TIMER_A, overflowIntHandler<3>); return true;
+        case TIMER4_BASE: s_overflowTimers[4] = timer; TimerIntRegister(base, TIMER_A, overflowIntHandler<4>); return true;
+        case TIMER5_BASE: s_overflowTimers[5] = timer; TimerIntRegister(base, TIMER_A, overflowIntHandler<5>); return true;
+        default: return false;
+    }
+}
 
 bool Timer::isWideBase(uint32_t base)
 {
@@ -60,32 +94,63 @@ bool Timer::enablePeripheralForBase(uint32_t base)
 bool Timer::begin(uint32_t sysclkHz, uint32_t timerBase)
 {
     m_base    = timerBase;
-    m_isWide  = isWideBase(timerBase);
     m_sysclkHz = sysclkHz;
+    if (timerBase == DWT_CYCCNT)      m_source = SOURCE_DWT;
+    else if (timerBase == MANUAL)     m_source = SOURCE_MANUAL;
+    else if (isWideBase(timerBase))   m_source = SOURCE_WIDE;
+    else                              m_source = SOURCE_GPTM32;
 
-    if (!enablePeripheralForBase(timerBase)) return false;
+    if (m_source != SOURCE_DWT && m_source != SOURCE_MANUAL &&
+        !enablePeripheralForBase(timerBase)) {
+        m_source = SOURCE_NONE;
+        return false;
+    }
 
     // ticks por microsegundo con redondeo
     // (evita sesgos cuando sysclkHz no es m�ltiplo exacto de 1 MHz)
     m_ticksPerUs = (m_sysclkHz + 500000u) / 1000000u;
     if (m_ticksPerUs == 0) m_ticksPerUs = 1; // evita divisi�n por cero
+    m_usDiv.set(m_ticksPerUs);
+    m_msDiv.set(m_ticksPerUs * 1000u);
+
+    if (m_source == SOURCE_DWT) {
+        // CYCCNT corre libre; no se pone a cero por si ya lo usa el depurador
+        HWREG(DEMCR) |= DEMCR_TRCENA;
+        HWREG(DWT_CTRL) |= DWT_CTRL_CYCCNTENA;
+        m_high = 0;
+        m_lastCycles = HWREG(DWT_CYCCNT);
+        m_start64 = counter64();
+        return true;
+    }
+    if (m_source == SOURCE_MANUAL) {
+        m_manual = 0;
+        m_start64 = counter64();
+        return true;
+    }
 
     // Configurar como peri�dico, down-counter, reloj del sistema
     TimerDisable(timerBase, TIMER_BOTH);
     TimerClockSourceSet(timerBase, TIMER_CLOCK_SYSTEM);
 
-    if (m_isWide) {
+    if (m_source == SOURCE_WIDE) {
         // 64-bit peri�dico
         TimerConfigure(timerBase, TIMER_CFG_PERIODIC);
         TimerLoadSet64(timerBase, 0xFFFFFFFFFFFFFFFFULL);  // down desde max
         TimerEnable(timerBase, TIMER_BOTH);                // habilita A y B como 64-bit
         m_start64 = TimerValueGet64(timerBase);
     } else {
-        // 32-bit peri�dico
+        // 32-bit peri�dico; la ISR de timeout cuenta las vueltas
         TimerConfigure(timerBase, TIMER_CFG_PERIODIC);
         TimerLoadSet(timerBase, TIMER_A, 0xFFFFFFFFu);     // down desde max
+        m_high = 0;
+        TimerIntClear(timerBase, TIMER_TIMA_TIMEOUT);
+        if (!registerOverflowIsr(timerBase, this)) {       // tambi�n la habilita en el NVIC
+            m_source = SOURCE_NONE;                      // como si no hubiera begin()
+            return false;
+        }
+        TimerIntEnable(timerBase, TIMER_TIMA_TIMEOUT);
         TimerEnable(timerBase, TIMER_A);
-        m_start32 = TimerValueGet(timerBase, TIMER_A);
+        m_start64 = counter64();
     }
 
     return true;
@@ -93,39 +158,106 @@ bool Timer::begin(uint32_t sysclkHz, uint32_t timerBase)
 
 void Timer::stop()
 {
-    if (m_base) TimerDisable(m_base, m_isWide ? TIMER_BOTH : TIMER_A);
+    if (isGptm()) TimerDisable(m_base, isWide() ? TIMER_BOTH : TIMER_A);
+}
+
+void Timer::advance(uint64_t n)
+{
+    if (m_source == SOURCE_MANUAL) m_manual += n;
 }
 
 void Timer::reset()
 {
-    if (!m_base) return;
-    if (m_isWide) {
-        m_start64 = TimerValueGet64(m_base);
-    } else {
-        m_start32 = TimerValueGet(m_base, TIMER_A);
-    }
+    if (m_source == SOURCE_NONE) return;
+    m_start64 = counter64();
 }
 
-uint64_t Timer::micros() const
+void Timer::overflowIsr()
 {
-    if (!m_base) return 0;
+    TimerIntClear(m_base, TIMER_TIMA_TIMEOUT);
+    m_high = m_high + 1;
+}
 
-    if (m_isWide) {
-        // Down-counter 64-bit
-        uint64_t now    = TimerValueGet64(m_base);
-        uint64_t dticks = (m_start64 - now);           // aritm�tica unsigned maneja wrap
-        // ticks -> �s (div. por ticks/�s)
-        return (m_ticksPerUs ? (dticks / m_ticksPerUs) : 0ULL);
-    } else {
-        // Down-counter 32-bit
-        uint32_t now    = TimerValueGet(m_base, TIMER_A);
-        uint32_t dticks = (m_start32 - now);           // unsigned maneja wrap (m�dulo 2^32)
-        return (m_ticksPerUs ? (uint64_t)dticks / m_ticksPerUs : 0ULL);
-    }
+uint64_t Timer::cycles64() const
+{
+    // Sin interrupción de desborde: una vuelta se detecta porque la lectura
+    // es menor que la anterior. Con interrupciones deshabilitadas para que
+    // una lectura desde una ISR no se cruce con la del loop.
+    bool wasDisabled = IntMasterDisable();
+    uint32_t now = HWREG(DWT_CYCCNT);
+    if (now < m_lastCycles) m_high = m_high + 1;
+    m_lastCycles = now;
+    uint64_t cycles = ((uint64_t)m_high << 32) | now;
+    if (!wasDisabled) IntMasterEnable();
+    return cycles;
+}
+
+uint64_t Timer::counter64() const
+{
+    if (m_source == SOURCE_WIDE) return TimerValueGet64(m_base);
+    // Ascendentes: el complemento baja igual que un down-counter
+    if (m_source == SOURCE_DWT) return ~cycles64();
+    if (m_source == SOURCE_MANUAL) return ~m_manual;
+
+    // Parte alta leída antes y después del contador: si la ISR corrió en
+    // medio, se repite. Si el timeout está pendiente pero la ISR aún no
+    // corrió (interrupciones deshabilitadas, o desde otra ISR de mayor
+    // prioridad) y el contador ya recargó, se cuenta esa vuelta aquí.
+    uint32_t hi, lo;
+    bool pending;
+    do {
+        hi = m_high;
+        lo = TimerValueGet(m_base, TIMER_A);
+        pending = (TimerIntStatus(m_base, false) & TIMER_TIMA_TIMEOUT) != 0;
+    } while (hi != m_high);
+    if (pending && lo > 0x7FFFFFFFu) hi++;
+
+    // Descendente como el del WTIMER: cada vuelta resta 2^32
+    return ((uint64_t)(uint32_t)~hi << 32) | lo;
+}
+
+uint64_t Timer::ticks() const
+{
+    if (m_source == SOURCE_NONE) return 0;
+    return deltaTicks();
+}
+
+uint64_t Timer::deltaTicks() const
+{
+    // Down-counter 64-bit (real o extendido)
+    return (m_start64 - counter64());                  // aritm�tica unsigned maneja wrap
+}
+
+uint64_t Timer::micros() const
+{
+    if (m_source == SOURCE_NONE) return 0;
+    // ticks -> µs: / m_ticksPerUs con multiplicación
+    return m_usDiv.divide(deltaTicks());
 }
 
 uint64_t Timer::millis() const
 {
-    // �s -> ms
-    return micros() / 1000ULL;
+    if (m_source == SOURCE_NONE) return 0;
+    // ticks -> ms en un paso: (t / m_ticksPerUs) / 1000 == t / (m_ticksPerUs * 1000)
+    return m_msDiv.divide(deltaTicks());
+}
+
+void Reciprocal::set(uint32_t d)
+{
+    one = (d <= 1);
+    if (one) { mul = 0; shift = 0; return; }
+
+    uint8_t l = 0;
+    while (l < 32 && (1ull << l) < d) ++l;     // l = ceil(log2 d)
+    shift = (uint8_t)(l - 1);
+
+    // floor(2^64 * (2^l - d) / d) por división larga: (2^l - d) < d, cabe en 64 bits
+    uint64_t r = (1ull << l) - d;
+    uint64_t q = 0;
+    for (int i = 0; i < 64; ++i) {
+        r <<= 1;
+        q <<= 1;
+        if (r >= d) { r -= d; q |= 1; }
+    }
+    mul = q + 1;
 }
@@ -10,14 +10,59 @@ extern "C" {
   #include "inc/hw_memmap.h"
 }
 
+/**
+ * Divisin por una constante de 32 bits con multiplicacin y desplazamiento
+ * (Granlund-Montgomery): divide(n) == n / d para todo n de 64 bits.
+ * set() hace la nica divisin (larga, bit a bit); divide() cuesta cuatro
+ * multiplicaciones de 32x32 en lugar de la llamada a __aeabi_uldivmod.
+ */
+struct Reciprocal {
+    uint64_t mul;      // floor(2^64 * (2^l - d) / d) + 1, con l = ceil(log2 d)
+    uint8_t  shift;    // l - 1
+    bool     one;      // d == 1
+
+    void set(uint32_t d);
+
+    uint64_t divide(uint64_t n) const {
+        if (one) return n;
+        uint64_t t = mulhi(mul, n);
+        return (t + ((n - t) >> 1)) >> shift;
+    }
+
+    // 64 bits altos del producto de 128 bits
+    static uint64_t mulhi(uint64_t a, uint64_t b) {
+        uint64_t aL = (uint32_t)a, aH = a >> 32;
+        uint64_t bL = (uint32_t)b, bH = b >> 32;
+        uint64_t ll = aL * bL, lh = aL * bH, hl = aH * bL, hh = aH * bH;
+        uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+        return hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+    }
+};
+
 class Timer {
 public:
+    /**
+     * Pseudo-bases para begin() que no son un GPTM:
+     * - DWT_CYCCNT: contador de ciclos del ncleo (DWT CYCCNT, 1 tick = 1 ciclo).
+     *   Se lee sin pasar por el bus de perifricos y no usa ningn timer ni
+     *   interrupcin. No tiene interrupcin de desborde: la parte alta se
+     *   extiende al leer, as que hay que leerlo al menos una vez cada 2^32
+     *   ciclos (~35.8 s a 120 MHz). Se detiene con el ncleo (SysCtlSleep y
+     *   el depurador en pausa), as que no sirve de reloj con TicklessIdle.
+     * - MANUAL: contador que solo avanza con advance(). No toca hardware; da
+     *   tiempo determinista para probar cdigo que depende del tiempo
+     *   (debounce, Scheduler, medidores) en host o en la placa.
+     */
+    static const uint32_t DWT_CYCCNT = 0xE0001004u;   // direccin del registro CYCCNT
+    static const uint32_t MANUAL     = 0xFFFFFFFFu;
+
     Timer();
 
     /**
      * @brief Inicializa el timer en modo peridico down-counter.
      * @param sysclkHz  Frecuencia de reloj del sistema (Hz), p.ej. 120000000.
-     * @param timerBase TIMERx_BASE (32-bit) o WTIMERx_BASE (64-bit).
+     * @param timerBase TIMERx_BASE (32-bit), WTIMERx_BASE (64-bit),
+     *                  Timer::DWT_CYCCNT o Timer::MANUAL.
      *                  Ej: TIMER1_BASE o WTIMER0_BASE.
      * @return true si se pudo inicializar, false en error.
      */
@@ -32,28 +77,72 @@ public:
     /** Tiempo transcurrido en milisegundos desde el begin()/reset(). */
     uint64_t millis() const;
 
+    /** Convierte ticks (p.ej. una lectura guardada de ticks()) a ms, como millis(). */
+    uint64_t toMillis(uint64_t ticks) const { return m_msDiv.divide(ticks); }
+
     /** Tiempo transcurrido en microsegundos desde el begin()/reset(). */
     uint64_t micros() const;
 
+    /**
+     * @brief Ticks de reloj transcurridos desde el begin()/reset(), sin convertir.
+     * Con Wide Timer (64-bit) es directo. Con timer de 32-bit la parte alta la
+     * lleva la ISR de timeout (una vez cada 2^32 ticks, ~35.8 s a 120 MHz),
+     * as que ticks(), micros() y millis() son montonos de 64 bits en ambos.
+     */
+    uint64_t ticks() const;
+
+    /**
+     * @brief Solo con MANUAL: avanza el contador n ticks (p.ej. en una prueba,
+     * n = clockHz() / 1000 por cada ms simulado). Sin efecto en otro backend.
+     */
+    void advance(uint64_t n);
+
+    /** Frecuencia de los ticks (Hz), la pasada a begin(). */
+    uint32_t clockHz() const { return m_sysclkHz; }
+
     /** Devuelve el base del timer configurado. */
     uint32_t base() const { return m_base; }
 
     /** Indica si est usando Wide Timer (64-bit). */
-    bool isWide() const { return m_isWide; }
+    bool isWide() const { return m_source == SOURCE_WIDE; }
 
-private:
-    // Helpers
+    /** true si el backend es un GPTM (TIMERx/WTIMERx), que sigue contando en reposo. */
+    bool isGptm() const { return m_source == SOURCE_WIDE || m_source == SOURCE_GPTM32; }
+
+    /** Habilita el reloj de un TIMERx/WTIMERx y espera a que est listo. */
     static bool enablePeripheralForBase(uint32_t base);
+
+    /** true si base es un WTIMERx_BASE (64-bit). */
     static bool isWideBase(uint32_t base);
 
+    /** Uso interno: ISR de timeout del timer de 32-bit (extiende la parte alta). */
+    void overflowIsr();
+
+private:
+    enum Source : uint8_t { SOURCE_NONE, SOURCE_GPTM32, SOURCE_WIDE, SOURCE_DWT, SOURCE_MANUAL };
+
+    // Ticks desde el origen
+    uint64_t deltaTicks() const;
+
+    // Contador descendente de 64 bits: el del WTIMER, la parte alta de la
+    // ISR unida al contador de 32-bit, o el complemento del CYCCNT/manual
+    uint64_t counter64() const;
+
+    // CYCCNT ascendente extendido a 64 bits en cada lectura
+    uint64_t cycles64() const;
+
     // Estado
-    uint32_t m_base;           // TIMERx_BASE o WTIMERx_BASE
-    bool     m_isWide;         // true si m_base es WTIMERx_BASE
+    uint32_t m_base;           // TIMERx_BASE, WTIMERx_BASE, DWT_CYCCNT o MANUAL
+    Source   m_source;         // backend segn m_base
     uint32_t m_sysclkHz;       // Hz del sistema
     uint32_t m_ticksPerUs;     // ticks de timer por microsegundo (redondeado)
+    Reciprocal m_usDiv;        // ticks -> us: / m_ticksPerUs
+    Reciprocal m_msDiv;        // ticks -> ms: / (m_ticksPerUs * 1000)
     // "Origen" (valor capturado al comenzar / reset). Siempre lector del contador descendente.
-    uint32_t m_start32;        // si 32-bit
-    uint64_t m_start64;        // si 64-bit
+    uint64_t m_start64;        // lectura de counter64()
+    mutable volatile uint32_t m_high;  // 32-bit: vueltas (ISR); DWT: vueltas vistas al leer
+    mutable uint32_t m_lastCycles;     // DWT: ltima lectura de CYCCNT
+    uint64_t m_manual;                 // MANUAL: ticks avanzados
 };
 
 #endif // TM4C_TIMER_H
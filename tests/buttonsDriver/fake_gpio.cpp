@@ -0,0 +1,73 @@
+// GPIO simulado para las pruebas de buttonsDriver (ver fake_gpio.h).
+
+#include "fake_gpio.h"
+#include "driverlib/gpio.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/timer.h"
+#include "driverlib/interrupt.h"
+
+static uint8_t  s_levels[NUM_PORTS];          // nivel de los 8 pines
+static uint8_t  s_intEnabled[NUM_PORTS];      // GPIOIntEnable()
+static uint8_t  s_intStatus[NUM_PORTS];       // flancos pendientes
+static void   (*s_handlers[NUM_PORTS])(void); // GPIOIntRegister()
+
+static uint8_t portOf(uint32_t base)
+{
+    for (uint8_t p = 0; p < NUM_PORTS; p++) {
+        if (port_to_base[p] == base) return p;
+    }
+    return 0;
+}
+
+void FakeGpio_reset(void)
+{
+    for (uint8_t p = 0; p < NUM_PORTS; p++) {
+        s_levels[p] = 0xFF;
+        s_intStatus[p] = 0;
+    }
+}
+
+void FakeGpio_set(uint8_t pin, bool active)
+{
+    uint8_t p = digital_pin_to_port[pin];
+    uint8_t mask = digital_pin_to_bit_mask[pin];
+    uint8_t level = active ? (uint8_t)(s_levels[p] & ~mask) : (uint8_t)(s_levels[p] | mask);
+    if (level == s_levels[p]) return;
+    s_levels[p] = level;
+    if (!(s_intEnabled[p] & mask)) return;
+    s_intStatus[p] |= mask;
+    if (s_handlers[p]) s_handlers[p]();
+}
+
+extern "C" {
+// ---- GPIO ---------------------------------------------------------------------
+void GPIOPinTypeGPIOInput(uint32_t, uint8_t) {}
+void GPIOPadConfigSet(uint32_t, uint8_t, uint32_t, uint32_t) {}
+int32_t GPIOPinRead(uint32_t base, uint8_t mask) { return s_levels[portOf(base)] & mask; }
+void GPIOIntTypeSet(uint32_t, uint8_t, uint32_t) {}
+void GPIOIntEnable(uint32_t base, uint32_t mask) { s_intEnabled[portOf(base)] |= (uint8_t)mask; }
+void GPIOIntDisable(uint32_t base, uint32_t mask) { s_intEnabled[portOf(base)] &= (uint8_t)~mask; }
+void GPIOIntClear(uint32_t base, uint32_t mask) { s_intStatus[portOf(base)] &= (uint8_t)~mask; }
+uint32_t GPIOIntStatus(uint32_t base, bool) { uint8_t p = portOf(base); return s_intStatus[p] & s_intEnabled[p]; }
+void GPIOIntRegister(uint32_t base, void (*handler)(void)) { s_handlers[portOf(base)] = handler; }
+
+// ---- SysCtl / interrupciones ------------------------------------------------
+void SysCtlPeripheralEnable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+bool IntMasterDisable(void) { return false; }
+bool IntMasterEnable(void) { return true; }
+
+// ---- timer (las pruebas usan Timer::MANUAL) ---------------------------------
+void TimerClockSourceSet(uint32_t, uint32_t) {}
+void TimerConfigure(uint32_t, uint32_t) {}
+void TimerEnable(uint32_t, uint32_t) {}
+void TimerDisable(uint32_t, uint32_t) {}
+void TimerLoadSet(uint32_t, uint32_t, uint32_t) {}
+void TimerLoadSet64(uint32_t, uint64_t) {}
+uint32_t TimerValueGet(uint32_t, uint32_t) { return 0; }
+uint64_t TimerValueGet64(uint32_t) { return 0; }
+void TimerIntClear(uint32_t, uint32_t) {}
+void TimerIntEnable(uint32_t, uint32_t) {}
+uint32_t TimerIntStatus(uint32_t, bool) { return 0; }
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void)) {}
+}
@@ -0,0 +1,22 @@
+// GPIO simulado para las pruebas de buttonsDriver.
+//
+// Implementa las llamadas de driverlib que usan los botones (GPIOPinRead,
+// interrupción por puerto, SysCtl) sobre un nivel por puerto, más las de
+// timer como vacías: las pruebas usan Timer::MANUAL. FakeGpio_set() cambia
+// el nivel de un pin y, si cambia y su interrupción está habilitada, marca
+// el flanco y llama a la ISR registrada del puerto, como el NVIC.
+
+#ifndef TESTS_FAKE_GPIO_H
+#define TESTS_FAKE_GPIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pins.h"
+
+// Nivel activo de un pin con pull-up (true = presionado = nivel bajo)
+void FakeGpio_set(uint8_t pin, bool active);
+
+// Todos los pines en alto (sueltos), sin flancos pendientes; llamar al empezar
+void FakeGpio_reset(void);
+
+#endif // TESTS_FAKE_GPIO_H
@@ -0,0 +1,181 @@
+// FSM de ButtonCore anterior a la tabla de transiciones (un switch por
+// estado, como OneButton), copiada con su debounce, reset() y banderas.
+// Es el modelo de referencia de test_button_fsm.cpp: sin pin ni reloj,
+// tick(nivel) avanza _tickIntervalMs y devuelve los bits BUTTON_EV_*.
+// Única diferencia con la tabla: aquí la segunda pulsación de un doble
+// click (OCS_COUNT -> OCS_DOWN) no emite BUTTON_EV_PRESS; la prueba lo
+// añade al comparar.
+
+#ifndef TESTS_SWITCH_FSM_H
+#define TESTS_SWITCH_FSM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "button.h"
+
+class SwitchButton {
+public:
+    enum class StateMachine : uint8_t {
+        OCS_INIT = 0,
+        OCS_DOWN = 1,
+        OCS_UP = 2,
+        OCS_COUNT = 3,
+        OCS_PRESS = 6,
+        OCS_PRESSEND = 7,
+    };
+
+    void setDebounceMs(int ms) { _debounceMs = ms; }
+    void setClickMs(unsigned int ms) { _clickMs = ms; }
+    void setPressMs(unsigned int ms) { _pressMs = ms; }
+    void setIdleMs(unsigned int ms) { _idleMs = ms; }
+    void setLongPressIntervalMs(unsigned int ms) { _longPressIntervalMs = ms; }
+    void setTickIntervalMs(unsigned int ms) { _tickIntervalMs = ms; }
+    void setMaxClicks(int n) { _maxClicks = n; }
+
+    uint16_t tick(bool activeLevel) {
+        _now += _tickIntervalMs;
+        return step(activeLevel);
+    }
+
+    StateMachine state() const { return _state; }
+    int getNumberClicks() const { return _nClicks; }
+    bool isIdle() const { return _state == StateMachine::OCS_INIT; }
+    bool isLongPressed() const { return _state == StateMachine::OCS_PRESS; }
+    unsigned long getHoldTime() const { return _holdTimeMs; }
+
+    bool wasPressed() { bool ret = _wasPressedFlag; _wasPressedFlag = false; return ret; }
+    bool wasReleased() { bool ret = _wasReleasedFlag; _wasReleasedFlag = false; return ret; }
+    bool isDoubleClicked() { bool ret = _doubleClickedFlag; _doubleClickedFlag = false; return ret; }
+
+private:
+    bool debounce(bool value) {
+        // Con _debounceMs < 0 el flanco a activo no espera
+        if (value && _debounceMs < 0) {
+            _debouncedLevel = value;
+        }
+
+        if (_lastDebounceLevel == value) {
+            if ((_now - _lastDebounceTime) >= (unsigned long)((_debounceMs < 0) ? -_debounceMs : _debounceMs))
+                _debouncedLevel = value;
+        } else {
+            _lastDebounceTime = _now;
+            _lastDebounceLevel = value;
+        }
+        return _debouncedLevel;
+    }
+
+    uint16_t step(bool physical) {
+        bool prevPhysical = _currentPhysicalLevel;
+        _currentPhysicalLevel = physical;
+        if (!prevPhysical && physical) _wasPressedFlag = true;
+        if (prevPhysical && !physical) _wasReleasedFlag = true;
+        return fsm(debounce(physical));
+    }
+
+    uint16_t fsm(bool activeLevel) {
+        unsigned long waitTime = (_now - _startTime);
+        uint16_t ev = 0;
+
+        switch (_state) {
+        case StateMachine::OCS_INIT:
+            if (!_idleState && (waitTime > _idleMs)) {
+                ev |= BUTTON_EV_IDLE;
+                _idleState = true;
+            }
+            if (activeLevel) {
+                _state = StateMachine::OCS_DOWN;
+                _startTime = _now;
+                _nClicks = 0;
+                ev |= BUTTON_EV_PRESS;
+                _holdTimeMs = 0;
+            }
+            break;
+
+        case StateMachine::OCS_DOWN:
+            if (!activeLevel) {
+                _state = StateMachine::OCS_UP;
+                _startTime = _now;
+                _holdTimeMs = _now - (_startTime - waitTime);
+                ev |= BUTTON_EV_RELEASE;
+            } else if (waitTime > _pressMs) {
+                ev |= BUTTON_EV_LONG_PRESS_START;
+                _state = StateMachine::OCS_PRESS;
+            }
+            break;
+
+        case StateMachine::OCS_UP:
+            _nClicks++;
+            if (_nClicks == 2) {
+                _doubleClickedFlag = true;
+            }
+            _state = StateMachine::OCS_COUNT;
+            break;
+
+        case StateMachine::OCS_COUNT:
+            if (activeLevel) {
+                _state = StateMachine::OCS_DOWN;
+                _startTime = _now;
+            } else if ((waitTime >= _clickMs) || (_nClicks == _maxClicks)) {
+                if (_nClicks == 1) {
+                    ev |= BUTTON_EV_CLICK;
+                } else if (_nClicks == 2) {
+                    ev |= BUTTON_EV_DOUBLE_CLICK;
+                } else {
+                    ev |= BUTTON_EV_MULTI_CLICK;
+                }
+                reset();
+            }
+            break;
+
+        case StateMachine::OCS_PRESS:
+            if (!activeLevel) {
+                _state = StateMachine::OCS_PRESSEND;
+            } else if ((_now - _lastDuringLongPressTime) >= _longPressIntervalMs) {
+                ev |= BUTTON_EV_DURING_LONG_PRESS;
+                _lastDuringLongPressTime = _now;
+            }
+            break;
+
+        case StateMachine::OCS_PRESSEND:
+            ev |= BUTTON_EV_LONG_PRESS_STOP;
+            reset();
+            break;
+        }
+        return ev;
+    }
+
+    void reset() {
+        _state = StateMachine::OCS_INIT;
+        _nClicks = 0;
+        _startTime = _now;
+        _idleState = false;
+        _wasPressedFlag = false;
+        _wasReleasedFlag = false;
+        _doubleClickedFlag = false;
+        _holdTimeMs = 0;
+    }
+
+    int _debounceMs = 50;
+    unsigned int _clickMs = 500;
+    unsigned int _pressMs = 1000;
+    unsigned int _idleMs = 1000;
+    unsigned int _longPressIntervalMs = 0;
+    unsigned int _tickIntervalMs = 20;
+    StateMachine _state = StateMachine::OCS_INIT;
+    bool _idleState = false;
+    bool _debouncedLevel = false;
+    bool _lastDebounceLevel = false;
+    unsigned long _lastDebounceTime = 0;
+    unsigned long _now = 0;
+    unsigned long _startTime = 0;
+    unsigned long _lastDuringLongPressTime = 0;
+    int _nClicks = 0;
+    int _maxClicks = 2;
+    bool _wasPressedFlag = false;
+    bool _wasReleasedFlag = false;
+    bool _currentPhysicalLevel = false;
+    bool _doubleClickedFlag = false;
+    unsigned long _holdTimeMs = 0;
+};
+
+#endif // TESTS_SWITCH_FSM_H
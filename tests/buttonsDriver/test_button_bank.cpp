@@ -0,0 +1,160 @@
+// Prueba en host de ButtonBank contra Button.
+//
+// Ocho Button con tick(bool) y un ButtonBank de 8 bits reciben los mismos
+// niveles (rachas aleatorias con rebotes de 0..2 ticks) con tiempos al
+// azar. Se comprueba que
+//   - el contador vertical acepta un cambio tras N + 1 muestras iguales,
+//     N = max(1, ceil(debounce / tick)), lo mismo que el debounce por tiempo
+//     de Button: pressed() se compara en cada tick con ese debounce,
+//     calculado bit a bit;
+//   - los eventos (bit, tick y tipo) son los mismos que los de los Button,
+//   - por encima de MAX_DEBOUNCE_TICKS ticks el debounce se recorta.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include <vector>
+#include "check.h"
+#include "fake_gpio.h"
+#include "button.h"
+#include "buttonBank.h"
+
+// Registro de un evento: tick, bit y tipo
+static std::vector<uint32_t> s_buttonLog, s_bankLog;
+static uint32_t s_tick;
+static uint8_t s_bit;                        // Button que está en tick()
+
+static void logEvent(std::vector<uint32_t>& log, uint8_t bit, char ev)
+{
+    log.push_back((s_tick << 12) | ((uint32_t)bit << 8) | (uint8_t)ev);
+}
+
+static void btnPress()       { logEvent(s_buttonLog, s_bit, 'p'); }
+static void btnRelease()     { logEvent(s_buttonLog, s_bit, 'r'); }
+static void btnClick()       { logEvent(s_buttonLog, s_bit, 'C'); }
+static void btnDouble()      { logEvent(s_buttonLog, s_bit, 'D'); }
+static void btnMulti()       { logEvent(s_buttonLog, s_bit, 'M'); }
+static void btnLongStart()   { logEvent(s_buttonLog, s_bit, 'L'); }
+static void btnDuring()      { logEvent(s_buttonLog, s_bit, 'W'); }
+static void btnLongStop()    { logEvent(s_buttonLog, s_bit, 'S'); }
+
+static void bankPress(uint8_t bit)     { logEvent(s_bankLog, bit, 'p'); }
+static void bankRelease(uint8_t bit)   { logEvent(s_bankLog, bit, 'r'); }
+static void bankClick(uint8_t bit)     { logEvent(s_bankLog, bit, 'C'); }
+static void bankDouble(uint8_t bit)    { logEvent(s_bankLog, bit, 'D'); }
+static void bankMulti(uint8_t bit)     { logEvent(s_bankLog, bit, 'M'); }
+static void bankLongStart(uint8_t bit) { logEvent(s_bankLog, bit, 'L'); }
+static void bankDuring(uint8_t bit)    { logEvent(s_bankLog, bit, 'W'); }
+static void bankLongStop(uint8_t bit)  { logEvent(s_bankLog, bit, 'S'); }
+
+// Debounce de Button (ButtonCore::debounce) para un bit, con tiempo en ms
+struct TimeDebounce {
+    bool level, last;
+    unsigned long lastTime;
+
+    bool step(bool value, unsigned long now, unsigned int debounceMs) {
+        if (last == value) {
+            if (now - lastTime >= debounceMs) level = value;
+        } else {
+            lastTime = now;
+            last = value;
+        }
+        return level;
+    }
+};
+
+int main()
+{
+    std::mt19937 rng(11);
+    FakeGpio_reset();
+
+    unsigned long events = 0, eventMismatches = 0, levelMismatches = 0;
+    for (int it = 0; it < 3000; it++) {
+        unsigned int T = rng() % 3 == 0 ? 10 : 20;
+        unsigned int D = rng() % (T * ButtonBank::MAX_DEBOUNCE_TICKS + 1);
+        unsigned int C = 100 + rng() % 500;
+        unsigned int P = 300 + rng() % 900;
+        unsigned int I = rng() % 3 ? 0 : 50 + rng() % 100;
+        bool multi = rng() % 2, during = rng() % 2;
+
+        std::vector<Button> buttons(8, Button(USR_SW1));
+        for (Button& b : buttons) {
+            b.setTickIntervalMs(T);
+            b.setDebounceMs(D);
+            b.setClickMs(C);
+            b.setPressMs(P);
+            b.setLongPressIntervalMs(I);
+            b.attachPress(btnPress);
+            b.attachRelease(btnRelease);
+            b.attachClick(btnClick);
+            b.attachDoubleClick(btnDouble);
+            if (multi) b.attachMultiClick(btnMulti);
+            b.attachLongPressStart(btnLongStart);
+            if (during) b.attachDuringLongPress(btnDuring);
+            b.attachLongPressStop(btnLongStop);
+        }
+
+        ButtonBank bank(PJ, 0xFF, ButtonPull::PullUp);
+        bank.setTickIntervalMs(T);
+        bank.setDebounceMs(D);
+        bank.setClickMs(C);
+        bank.setPressMs(P);
+        bank.setLongPressIntervalMs(I);
+        bank.attachPress(bankPress);
+        bank.attachRelease(bankRelease);
+        bank.attachClick(bankClick);
+        bank.attachDoubleClick(bankDouble);
+        if (multi) bank.attachMultiClick(bankMulti);
+        bank.attachLongPressStart(bankLongStart);
+        if (during) bank.attachDuringLongPress(bankDuring);
+        bank.attachLongPressStop(bankLongStop);
+
+        s_buttonLog.clear();
+        s_bankLog.clear();
+        TimeDebounce ref[8] = {};
+        uint8_t active = 0;
+        int run[8] = {};
+        for (s_tick = 0; s_tick < 3000; s_tick++) {
+            // Rachas aleatorias por bit; una de cada cuatro es un rebote de 0..2 ticks
+            for (int i = 0; i < 8; i++) {
+                if (run[i]-- <= 0) {
+                    active ^= (uint8_t)(1u << i);
+                    run[i] = rng() % 4 == 0 ? rng() % 3 : rng() % (2 * P / T + 10);
+                }
+            }
+            uint8_t refLevels = 0;
+            for (s_bit = 0; s_bit < 8; s_bit++) {
+                bool a = (active >> s_bit) & 1;
+                buttons[s_bit].tick(a);
+                if (ref[s_bit].step(a, (s_tick + 1) * T, D)) refLevels |= (uint8_t)(1u << s_bit);
+            }
+            bank.tick((uint8_t)~active);    // pull-up: activo bajo
+            if (bank.pressed() != refLevels) levelMismatches++;
+        }
+
+        events += s_buttonLog.size();
+        if (s_buttonLog != s_bankLog && eventMismatches++ < 3) {
+            printf("iteración %d, tick %u ms, debounce %u ms: %zu eventos de Button, %zu del banco\n",
+                   it, T, D, s_buttonLog.size(), s_bankLog.size());
+        }
+    }
+    CHECK_EQ(levelMismatches, 0);
+    CHECK_EQ(eventMismatches, 0);
+    CHECK(events > 100000);
+
+    // Debounce recortado: por encima de MAX_DEBOUNCE_TICKS ticks el banco
+    // acepta el cambio a MAX_DEBOUNCE_TICKS + 1 muestras
+    {
+        ButtonBank bank(PJ, GPIO_PIN_0);
+        bank.setTickIntervalMs(10);
+        bank.setDebounceMs(200);
+        int samples = 0;
+        while (!bank.pressed() && samples < 100) {
+            bank.tick((uint8_t)~GPIO_PIN_0);
+            samples++;
+        }
+        CHECK_EQ(samples, ButtonBank::MAX_DEBOUNCE_TICKS + 1);
+    }
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,157 @@
+// Prueba en host de Button::setClock() con un Timer::MANUAL.
+//
+// Secuencias aleatorias de pulsaciones (lejos de los umbrales de click y
+// long press) se dan a tres Button:
+//   - referencia: tick() cada 1 ms, tiempo por setTickIntervalMs(1),
+//   - reloj: setClock(timer) y tick() a intervalos aleatorios de 1 us a G ms,
+//     con el timer avanzado lo mismo,
+//   - sin reloj, con el mismo jitter y setTickIntervalMs(G / 2) (la media).
+// Con reloj los eventos son los de la referencia y getHoldTime() en cada
+// Release difiere a lo sumo en dos huecos entre tick(); sin reloj los
+// tiempos se estiran o encogen y los eventos cambian.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "fake_gpio.h"
+#include "button.h"
+
+static const uint32_t HZ = 1000000;          // 1 MHz
+static const uint64_t TPM = HZ / 1000;       // ticks por ms
+static const int DEBOUNCE = 30;
+static const unsigned int CLICK = 300, PRESS = 700;
+
+// Eventos de un Button y el tiempo presionado de cada Release
+struct Log {
+    std::string events;
+    std::vector<unsigned long> holds;
+    Button* button;
+};
+static Log* s_log;
+
+static void onPress()     { s_log->events += 'p'; }
+static void onRelease()   { s_log->events += 'r'; s_log->holds.push_back(s_log->button->getHoldTime()); }
+static void onClick()     { s_log->events += 'C'; }
+static void onDouble()    { s_log->events += 'D'; }
+static void onLongStart() { s_log->events += 'L'; }
+static void onLongStop()  { s_log->events += 'l'; }
+
+static void setup(Button& b, Log& log)
+{
+    b.setDebounceMs(DEBOUNCE);
+    b.setClickMs(CLICK);
+    b.setPressMs(PRESS);
+    b.attachPress(onPress);
+    b.attachRelease(onRelease);
+    b.attachClick(onClick);
+    b.attachDoubleClick(onDouble);
+    b.attachLongPressStart(onLongStart);
+    b.attachLongPressStop(onLongStop);
+    log.button = &b;
+    s_log = &log;
+}
+
+// Tramo de la entrada: duración (ms) y nivel activo
+struct Seg { uint32_t ms; bool active; };
+
+// Nivel de la entrada en el instante tUs (us desde el inicio)
+static bool levelAt(const std::vector<Seg>& seq, uint64_t tUs)
+{
+    uint64_t end = 0;
+    for (const Seg& s : seq) {
+        end += (uint64_t)s.ms * 1000;
+        if (tUs < end) return s.active;
+    }
+    return false;
+}
+
+int main()
+{
+    std::mt19937 rng(25);
+    FakeGpio_reset();
+
+    const uint32_t gaps[] = { 5, 10, 20, 45 };
+    unsigned long mismatches = 0, holdErrors = 0, releases = 0, softwareMismatches = 0;
+    for (int c = 0; c < 4000; c++) {
+        // Entre dos tick() hay hasta G ms: el debounce retrasa cada flanco
+        // entre DEBOUNCE y DEBOUNCE + 2G, y los tramos evitan ese margen
+        // alrededor de los umbrales
+        uint32_t G = gaps[c % 4], margin = 2 * G + 5;
+        std::vector<Seg> seq = { { 200, false } };
+        int n = 2 + rng() % 12;
+        for (int k = 0; k < n; k++) {
+            uint32_t active, idle;
+            do {
+                active = DEBOUNCE + margin + rng() % (rng() % 3 ? 500 : 1500);
+            } while (active + margin >= PRESS && active <= PRESS + margin + DEBOUNCE);
+            do {
+                idle = DEBOUNCE + margin + rng() % (rng() % 2 ? 400 : 900);
+            } while (idle + margin >= CLICK && idle <= CLICK + margin + DEBOUNCE);
+            seq.push_back({ active, true });
+            seq.push_back({ idle, false });
+        }
+        seq.push_back({ PRESS + CLICK + 200, false });
+        uint64_t totalUs = 0;
+        for (const Seg& s : seq) totalUs += (uint64_t)s.ms * 1000;
+
+        Log ref;
+        {
+            Button b(USR_SW1);
+            b.setTickIntervalMs(1);
+            setup(b, ref);
+            for (const Seg& s : seq) {
+                for (uint32_t i = 0; i < s.ms; i++) b.tick(s.active);
+            }
+        }
+
+        Log clocked;
+        {
+            Timer timer;
+            CHECK(timer.begin(HZ, Timer::MANUAL));
+            timer.advance((uint64_t)(rng() % 5000) * TPM);   // origen arbitrario
+            Button b(USR_SW1);
+            setup(b, clocked);
+            b.setClock(timer);
+            for (uint64_t tUs = 0; tUs < totalUs; ) {
+                uint64_t step = 1 + rng() % (G * 1000);
+                timer.advance(step * TPM / 1000);
+                tUs += step;
+                b.tick(levelAt(seq, tUs));
+            }
+        }
+
+        Log software;
+        {
+            Button b(USR_SW1);
+            b.setTickIntervalMs(G / 2);
+            setup(b, software);
+            for (uint64_t tUs = 0; tUs < totalUs; ) {
+                tUs += 1 + rng() % (G * 1000);
+                b.tick(levelAt(seq, tUs));
+            }
+        }
+
+        if (clocked.events != ref.events) {
+            if (mismatches++ < 3) {
+                printf("G = %u ms: referencia '%s', con reloj '%s'\n",
+                       G, ref.events.c_str(), clocked.events.c_str());
+            }
+        } else {
+            for (size_t i = 0; i < ref.holds.size(); i++, releases++) {
+                long err = labs((long)clocked.holds[i] - (long)ref.holds[i]);
+                if (err > (long)(2 * G + 1)) holdErrors++;
+            }
+        }
+        if (software.events != ref.events) softwareMismatches++;
+    }
+    CHECK_EQ(mismatches, 0);
+    CHECK_EQ(holdErrors, 0);
+    CHECK(releases > 10000);
+    CHECK(softwareMismatches > 100);
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,153 @@
+// Prueba en host de la FSM por tabla de ButtonCore y de ButtonEventQueue.
+//
+// Se comprueba que
+//   - dos pulsaciones dentro de la ventana de click dan Press, Release,
+//     Press, Release y DoubleClick: cada pulsación tiene su Press,
+//   - con niveles y configuraciones al azar (debounce negativo incluido,
+//     maxClicks 2..5 o 100) la tabla da los mismos eventos, clicks, estado,
+//     tiempo presionado y banderas que la FSM switch anterior
+//     (switch_fsm.h), más el Press de OCS_COUNT -> OCS_DOWN,
+//   - cada registro de la cola lleva el evento, id, tiempo, clicks y tiempo
+//     presionado de ese paso,
+//   - Press y Release/LongPressStop van en pareja.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include "check.h"
+#include "fake_gpio.h"
+#include "button.h"
+#include "buttonEvents.h"
+#include "switch_fsm.h"
+
+// Tramo de la entrada: duración (ms) y nivel activo
+struct Seg { uint32_t ms; bool active; };
+
+int main()
+{
+    FakeGpio_reset();
+
+    // Doble click: pulsar 100 ms, soltar 200 ms, pulsar 100 ms y soltar
+    {
+        SimpleButton b(USR_SW1);
+        b.setTickIntervalMs(10);
+        b.setDebounceMs(30);
+        b.setClickMs(400);
+        b.setPressMs(800);
+        ButtonEventQueue<16> q;
+        const Seg seq[] = { { 100, true }, { 200, false }, { 100, true }, { 1000, false } };
+        for (const Seg& s : seq) {
+            for (uint32_t ms = 0; ms < s.ms; ms += 10) q.tick(b, 3, s.active);
+        }
+
+        const ButtonEvent expected[] = { ButtonEvent::Press, ButtonEvent::Release, ButtonEvent::Press,
+                                         ButtonEvent::Release, ButtonEvent::DoubleClick };
+        ButtonEventRecord r = {};
+        for (ButtonEvent e : expected) {
+            CHECK(q.pop(r) && r.event == e && r.id == 3);
+            if (e == ButtonEvent::Release) CHECK_EQ(r.holdMs, 100);
+            if (e == ButtonEvent::DoubleClick) CHECK_EQ(r.clicks, 2);
+        }
+        CHECK(!q.pop(r));
+    }
+
+    // Diferencial contra la FSM switch
+    std::mt19937 rng(24);
+    unsigned long steps = 0, records = 0, bad = 0, unpaired = 0;
+    unsigned long perEvent[9] = {};
+    for (int c = 0; c < 5000; c++) {
+        int deb = (int)(rng() % 80) - (rng() % 8 == 0 ? 40 : 0);
+        unsigned int click = rng() % 600, press = rng() % 1500, idle = rng() % 2000;
+        unsigned int lpi = rng() % 300, tk = 1 + rng() % 25;
+        int maxClicks = rng() % 3 == 0 ? 100 : 2 + rng() % 4;
+
+        SwitchButton o;
+        SimpleButton n(USR_SW1);
+        o.setDebounceMs(deb);          n.setDebounceMs(deb);
+        o.setClickMs(click);           n.setClickMs(click);
+        o.setPressMs(press);           n.setPressMs(press);
+        o.setIdleMs(idle);             n.setIdleMs(idle);
+        o.setLongPressIntervalMs(lpi); n.setLongPressIntervalMs(lpi);
+        o.setTickIntervalMs(tk);       n.setTickIntervalMs(tk);
+        o.setMaxClicks(maxClicks);     n.setMaxClicks(maxClicks);
+        ButtonEventQueue<32> q;
+
+        bool a = false, down = false;
+        int segs = 5 + rng() % 40, prevClicks = 0;
+        unsigned long t = 0, pressT = 0;
+        for (int s = 0; s < segs; s++) {
+            uint32_t len = 1 + rng() % (rng() % 2 ? 4 : (rng() % 2 ? 60 : 200));
+            for (uint32_t k = 0; k < len; k++, steps++) {
+                bool wasCount = o.state() == SwitchButton::StateMachine::OCS_COUNT;
+                uint16_t m = o.tick(a);
+                if (wasCount && o.state() == SwitchButton::StateMachine::OCS_DOWN) m |= BUTTON_EV_PRESS;
+                q.tick(n, 7, a);
+                t += tk;
+
+                ButtonEventRecord r = {};
+                for (int e = 0; e < 9; e++) {
+                    if (!(m & (1u << e))) continue;
+                    perEvent[e]++;
+                    if (!q.pop(r)) { bad++; break; }
+                    records++;
+                    bool ok = r.event == (ButtonEvent)e && r.id == 7 && r.timeMs == (uint32_t)t;
+                    switch ((ButtonEvent)e) {
+                    case ButtonEvent::Release:
+                        ok = ok && r.holdMs == o.getHoldTime();
+                        break;
+                    case ButtonEvent::LongPressStart:
+                        // primer paso con más de _pressMs presionado
+                        ok = ok && r.holdMs > press && r.holdMs <= press + tk;
+                        pressT = t - r.holdMs;
+                        break;
+                    case ButtonEvent::DuringLongPress:
+                    case ButtonEvent::LongPressStop:
+                        ok = ok && r.holdMs == (uint32_t)(t - pressT);
+                        break;
+                    case ButtonEvent::Click:
+                    case ButtonEvent::DoubleClick:
+                    case ButtonEvent::MultiClick:
+                        ok = ok && r.clicks == prevClicks;
+                        break;
+                    default:
+                        break;
+                    }
+                    if (!ok && bad++ < 5) {
+                        printf("config %d, t = %lu ms: evento %d, hold %u, clicks %u\n",
+                               c, t, e, r.holdMs, r.clicks);
+                    }
+
+                    // Press y Release/LongPressStop alternan
+                    if (r.event == ButtonEvent::Press) {
+                        if (down) unpaired++;
+                        down = true;
+                    } else if (r.event == ButtonEvent::Release || r.event == ButtonEvent::LongPressStop) {
+                        if (!down) unpaired++;
+                        down = false;
+                    }
+                }
+                if (q.pop(r) && bad++ < 5) printf("config %d: registro de más\n", c);
+
+                if (o.getNumberClicks() != n.getNumberClicks() || o.isIdle() != n.isIdle() ||
+                    o.isLongPressed() != n.isLongPressed() || o.getHoldTime() != n.getHoldTime()) {
+                    if (bad++ < 5) printf("config %d, t = %lu ms: estado distinto\n", c, t);
+                }
+                if (rng() % 4 == 0 &&
+                    (o.wasPressed() != n.wasPressed() || o.wasReleased() != n.wasReleased() ||
+                     o.isDoubleClicked() != n.isDoubleClicked())) {
+                    if (bad++ < 5) printf("config %d, t = %lu ms: banderas distintas\n", c, t);
+                }
+                prevClicks = o.getNumberClicks();
+            }
+            a = rng() % 5 == 0 ? a : !a;
+        }
+    }
+    CHECK_EQ(bad, 0);
+    CHECK_EQ(unpaired, 0);
+    CHECK(steps > 1000000);
+    // Todos los tipos de evento aparecen
+    for (unsigned long count : perEvent) CHECK(count > 100);
+    CHECK(records > 100000);
+
+    return CHECK_RESULT();
+}
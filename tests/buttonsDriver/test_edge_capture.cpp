@@ -0,0 +1,253 @@
+// Prueba en host del modo interrupción (ButtonEdgeCapture).
+//
+// Los flancos se inyectan en el GPIO simulado, que llama a la ISR del
+// puerto como el NVIC; el reloj es Timer::MANUAL. Se comprueba que
+//   - una pulsación de 60 ms entre dos tick() de 200 ms, que el sondeo
+//     pierde, da Press + Click,
+//   - con secuencias aleatorias de pulsaciones, con y sin rebotes más cortos
+//     que el debounce, y tick() irregular cada 20..22 ms, los eventos son los
+//     mismos que con sondeo cada 1 ms,
+//   - dos botones del mismo puerto comparten la ISR sin mezclar flancos,
+//   - la cola llena cuenta los flancos perdidos,
+//   - una captura reutilizada con un botón de otro puerto sale de la lista
+//     del puerto anterior y el pin anterior deja de interrumpir,
+//   - en un puerto sin interrupción por puerto (P) beginInterrupt() falla y
+//     tick(edges) sigue en sondeo con tiempo real.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "check.h"
+#include "fake_gpio.h"
+#include "button.h"
+
+static const uint32_t SYSCLK = 120000000;
+static const uint64_t TPM = SYSCLK / 1000;   // ticks por ms
+
+static Timer s_clock;
+static std::string s_log;
+
+// Las capturas quedan enlazadas en la lista de la ISR del puerto (en la
+// placa son objetos estáticos): una por pin, reutilizada con cada Button
+static ButtonEdgeCapture s_edges1, s_edges2;
+
+static void onPress()     { s_log += "p"; }
+static void onClick()     { s_log += "C"; }
+static void onDouble()    { s_log += "D"; }
+static void onLongStart() { s_log += "L"; }
+static void onLongStop()  { s_log += "l"; }
+
+static void setup(Button& b)
+{
+    b.setDebounceMs(30);
+    b.setClickMs(400);
+    b.setPressMs(800);
+    b.attachPress(onPress);
+    b.attachClick(onClick);
+    b.attachDoubleClick(onDouble);
+    b.attachLongPressStart(onLongStart);
+    b.attachLongPressStop(onLongStop);
+}
+
+// Tramo de la entrada: duración (ms) y nivel activo
+struct Seg { uint32_t ms; bool active; };
+
+// Referencia: sondeo cada 1 ms con el nivel lógico
+static std::string runPolled(const std::vector<Seg>& seq)
+{
+    s_log.clear();
+    Button b(USR_SW1);
+    b.setTickIntervalMs(1);
+    setup(b);
+    for (const Seg& s : seq) {
+        for (uint32_t i = 0; i < s.ms; i++) b.tick(s.active);
+    }
+    return s_log;
+}
+
+// Modo interrupción: flancos en el GPIO, tick(edges) cada pollMs..pollMs+2 ms.
+// Con bounces, cada flanco lleva detrás 'bounces' pares de rebotes de 0.25 ms.
+static std::string runCaptured(const std::vector<Seg>& seq, uint32_t pollMs,
+                               std::mt19937& rng, uint32_t bounces)
+{
+    s_log.clear();
+    FakeGpio_reset();
+    Button b(USR_SW1);
+    ButtonEdgeCapture& edges = s_edges1;
+    uint32_t dropped = edges.dropped();
+    setup(b);
+    CHECK(b.beginInterrupt(edges, s_clock));
+
+    uint64_t now = s_clock.ticks();
+    uint64_t nextPoll = now + pollMs * TPM;
+    auto advanceTo = [&](uint64_t until) {
+        while (nextPoll <= until) {
+            s_clock.advance(nextPoll - now);
+            now = nextPoll;
+            b.tick(edges);
+            nextPoll += (pollMs + rng() % 3) * TPM;
+        }
+        s_clock.advance(until - now);
+        now = until;
+    };
+
+    for (const Seg& s : seq) {
+        FakeGpio_set(USR_SW1, s.active);
+        for (uint32_t k = 0; k < bounces; k++) {
+            advanceTo(now + TPM / 4);
+            FakeGpio_set(USR_SW1, !s.active);
+            advanceTo(now + TPM / 4);
+            FakeGpio_set(USR_SW1, s.active);
+        }
+        advanceTo(now + s.ms * TPM - bounces * TPM / 2);
+    }
+    CHECK_EQ(edges.dropped(), dropped);
+    return s_log;
+}
+
+// Duración al azar, lejos (más de 3 ms) de los umbrales 30 / 400 / 800 ms
+static uint32_t pickMs(std::mt19937& rng, bool active)
+{
+    static const uint32_t act[] = { 40, 120, 300, 700, 900, 1500 };
+    static const uint32_t idle[] = { 40, 120, 300, 450, 1200 };
+    uint32_t v = active ? act[rng() % 6] : idle[rng() % 5];
+    v += rng() % 40;
+    for (uint32_t th : { 30u, 400u, 800u }) {
+        if (v + 4 > th && v < th + 4) v = th + 10;
+    }
+    return v;
+}
+
+int main()
+{
+    std::mt19937 rng(7);
+    CHECK(s_clock.begin(SYSCLK, Timer::MANUAL));
+
+    // Pulsación de 60 ms entre dos ticks de 200 ms
+    {
+        std::vector<Seg> seq = { { 50, false }, { 60, true }, { 1500, false } };
+
+        s_log.clear();
+        FakeGpio_reset();
+        Button polled(USR_SW1);
+        polled.setTickIntervalMs(200);
+        setup(polled);
+        uint32_t ms = 0;
+        for (const Seg& s : seq) {
+            for (uint32_t i = 0; i < s.ms; i++, ms++) {
+                FakeGpio_set(USR_SW1, s.active);
+                if (ms % 200 == 199) polled.tick();
+            }
+        }
+        CHECK(s_log == "");
+
+        CHECK(runCaptured(seq, 200, rng, 0) == "pC");
+    }
+
+    // Diferencial contra el sondeo a 1 ms
+    unsigned long mismatches = 0;
+    for (int it = 0; it < 2000; it++) {
+        std::vector<Seg> seq = { { 500, false } };
+        int n = 1 + rng() % 6;
+        for (int k = 0; k < n; k++) {
+            seq.push_back({ pickMs(rng, true), true });
+            seq.push_back({ pickMs(rng, false), false });
+        }
+        seq.push_back({ 1500, false });
+
+        std::string ref = runPolled(seq);
+        std::string got = runCaptured(seq, 20, rng, it % 2 ? 3 : 0);
+        if (ref != got && mismatches++ < 5) {
+            printf("sondeo '%s', interrupción '%s':", ref.c_str(), got.c_str());
+            for (const Seg& s : seq) printf(" %u%c", s.ms, s.active ? '+' : '-');
+            printf("\n");
+        }
+    }
+    CHECK_EQ(mismatches, 0);
+
+    // Dos botones del mismo puerto (J): cada uno ve solo sus flancos
+    {
+        FakeGpio_reset();
+        SimpleButton b1(USR_SW1), b2(USR_SW2);
+        CHECK(b1.beginInterrupt(s_edges1, s_clock));
+        CHECK(b2.beginInterrupt(s_edges2, s_clock));
+        FakeGpio_set(USR_SW2, true);
+        s_clock.advance(5 * TPM);
+        FakeGpio_set(USR_SW2, false);
+        b1.tick(s_edges1);
+        b2.tick(s_edges2);
+        CHECK(!b1.wasPressed());
+        CHECK(b2.wasPressed() && b2.wasReleased());
+    }
+
+    // Cola llena: QUEUE registros (el primero es el nivel inicial)
+    {
+        FakeGpio_reset();
+        SimpleButton b(USR_SW1), other(USR_SW2);
+        CHECK(b.beginInterrupt(s_edges1, s_clock));
+        CHECK(other.beginInterrupt(s_edges2, s_clock));
+        uint32_t dropped = s_edges1.dropped();
+        for (uint32_t i = 0; i < ButtonEdgeCapture::QUEUE + 4; i++) {
+            FakeGpio_set(USR_SW1, i % 2 == 0);
+        }
+        CHECK_EQ(s_edges1.dropped() - dropped, 5);
+        b.tick(s_edges1);
+        FakeGpio_set(USR_SW1, true);
+        CHECK_EQ(s_edges1.dropped() - dropped, 5);
+    }
+
+    // Captura reutilizada en otro puerto: s_edges1 pasa de USR_SW1 (PJ0) a
+    // PN_1; los flancos de PJ1 (bit 1, el mismo que PN_1) no le llegan
+    {
+        FakeGpio_reset();
+        SimpleButton sw1(USR_SW1), sw2(USR_SW2), led(PN_1);
+        CHECK(sw1.beginInterrupt(s_edges1, s_clock));
+        CHECK(sw2.beginInterrupt(s_edges2, s_clock));
+        CHECK(led.beginInterrupt(s_edges1, s_clock));
+        led.tick(s_edges1);
+        led.wasPressed();
+        FakeGpio_set(USR_SW2, true);
+        FakeGpio_set(USR_SW1, true);
+        s_clock.advance(5 * TPM);
+        FakeGpio_set(USR_SW2, false);
+        FakeGpio_set(USR_SW1, false);
+        led.tick(s_edges1);
+        sw2.tick(s_edges2);
+        CHECK(!led.wasPressed());
+        CHECK(sw2.wasPressed());
+        FakeGpio_set(PN_1, true);
+        led.tick(s_edges1);
+        CHECK(led.wasPressed());
+        FakeGpio_set(PN_1, false);
+
+        // Y de vuelta a PJ0
+        CHECK(sw1.beginInterrupt(s_edges1, s_clock));
+        sw1.tick(s_edges1);
+        FakeGpio_set(PN_1, true);
+        FakeGpio_set(USR_SW1, true);
+        sw1.tick(s_edges1);
+        CHECK(sw1.wasPressed());
+        FakeGpio_set(PN_1, false);
+        FakeGpio_set(USR_SW1, false);
+    }
+
+    // Puerto P: sin interrupción por puerto, sigue en sondeo con el reloj
+    {
+        FakeGpio_reset();
+        s_log.clear();
+        Button b(PP_2);
+        ButtonEdgeCapture edges;
+        setup(b);
+        CHECK(!b.beginInterrupt(edges, s_clock));
+        for (int ms = 0; ms < 1500; ms++) {
+            FakeGpio_set(PP_2, ms >= 100 && ms < 200);
+            s_clock.advance(TPM);
+            if (ms % 10 == 0) b.tick(edges);
+        }
+        CHECK(s_log == "pC");
+    }
+
+    return CHECK_RESULT();
+}
@@ -0,0 +1,42 @@
+//*****************************************************************************
+//
+// check.h - Minimal assertion helpers for the host tests.
+//
+// CHECK() reports the failing expression with its location and keeps going,
+// so one run lists every failure. CHECK_RESULT() is the exit status of the
+// test program: 0 if every check passed.
+//
+//*****************************************************************************
+
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <stdio.h>
+
+static unsigned long g_ulChecks, g_ulFailures;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        g_ulChecks++;                                                       \
+        if (!(cond)) {                                                      \
+            g_ulFailures++;                                                 \
+            printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                      \
+    do {                                                                    \
+        long long _a = (long long)(a), _b = (long long)(b);                 \
+        g_ulChecks++;                                                       \
+        if (_a != _b) {                                                     \
+            g_ulFailures++;                                                 \
+            printf("%s:%d: CHECK_EQ(%s, %s) failed: %lld != %lld\n",        \
+                   __FILE__, __LINE__, #a, #b, _a, _b);                     \
+        }                                                                   \
+    } while (0)
+
+#define CHECK_RESULT()                                                      \
+    (printf("%lu checks, %lu failed\n", g_ulChecks, g_ulFailures),          \
+     g_ulFailures != 0)
+
+#endif // TESTS_CHECK_H
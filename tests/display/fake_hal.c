@@ -0,0 +1,124 @@
+//*****************************************************************************
+//
+// fake_hal.c - Stand-in for HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.c
+// that hands every byte straight to the panel model instead of the SSI.
+//
+// Interrupt-driven transfers run to completion inside HAL_LCD_startTransfer(),
+// so the asynchronous flush looks like a blocking one to the driver.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+#include "Crystalfontz128x128_ST7735.h"
+#include "panel.h"
+
+void SysCtlDelay(uint32_t ui32Count)
+{
+    (void)ui32Count;
+}
+
+void HAL_LCD_PortInit(void)
+{
+}
+
+void HAL_LCD_SpiInit(void)
+{
+}
+
+void HAL_LCD_writeCommand(uint8_t command)
+{
+    Panel_byte(false, command);
+}
+
+void HAL_LCD_writeData(uint8_t data)
+{
+    Panel_byte(true, data);
+}
+
+void HAL_LCD_writeDataBurst(const uint8_t *pui8Data, uint32_t ui32Count)
+{
+    while (ui32Count--)
+    {
+        Panel_byte(true, *pui8Data++);
+    }
+}
+
+// Sends one pixel in the frame buffer format, as the real HAL puts it on the bus
+static void HAL_LCD_sendPixel(uint16_t ui16Pixel)
+{
+#if LCD_SSI_PIXEL_16BIT
+    Panel_byte(true, (uint8_t)(ui16Pixel >> 8));
+    Panel_byte(true, (uint8_t)ui16Pixel);
+#else
+    Panel_byte(true, (uint8_t)ui16Pixel);
+    Panel_byte(true, (uint8_t)(ui16Pixel >> 8));
+#endif
+}
+
+void HAL_LCD_writePixelBurst(const uint16_t *pui16Pixels, uint32_t ui32Count)
+{
+    while (ui32Count--)
+    {
+        HAL_LCD_sendPixel(*pui16Pixels++);
+    }
+}
+
+void HAL_LCD_writeIndexedBurst(const uint8_t *pui8Indices, uint32_t ui32Count,
+                               uint32_t ui32Bits, const uint16_t *pui16Palette)
+{
+    uint32_t i;
+
+    for (i = 0; i < ui32Count; i++)
+    {
+        if (ui32Bits == 4)
+        {
+            HAL_LCD_sendPixel(pui16Palette[(i & 1) ? (pui8Indices[i >> 1] & 15) : (pui8Indices[i >> 1] >> 4)]);
+        }
+        else
+        {
+            HAL_LCD_sendPixel(pui16Palette[pui8Indices[i]]);
+        }
+    }
+}
+
+void HAL_LCD_startTransfer(const tLcdTransfer *psTransfers, uint32_t ui32Count,
+                           void (*pfnDone)(void))
+{
+    uint32_t ui32Row;
+    const uint8_t *pui8Row;
+
+    for (; ui32Count; ui32Count--, psTransfers++)
+    {
+        Panel_byte(false, psTransfers->ui8Command);
+        for (ui32Row = 0; ui32Row < psTransfers->ui16Rows; ui32Row++)
+        {
+            pui8Row = psTransfers->pui8Data + ui32Row * psTransfers->ui16RowStride;
+            if (!psTransfers->bPixels)
+            {
+                HAL_LCD_writeDataBurst(pui8Row, psTransfers->ui16RowBytes);
+            }
+            else if (psTransfers->pui16Palette)
+            {
+                HAL_LCD_writeIndexedBurst(pui8Row, psTransfers->ui16RowBytes * 8 / psTransfers->ui8IndexBits,
+                                          psTransfers->ui8IndexBits, psTransfers->pui16Palette);
+            }
+            else
+            {
+                HAL_LCD_writePixelBurst((const uint16_t *)pui8Row, psTransfers->ui16RowBytes / 2);
+            }
+        }
+    }
+    if (pfnDone) pfnDone();
+}
+
+bool HAL_LCD_isTransferBusy(void)
+{
+    return false;
+}
+
+uint32_t HAL_LCD_transferPosition(void)
+{
+    return 0xffff0000; // past the last step
+}
@@ -0,0 +1,148 @@
+//*****************************************************************************
+//
+// panel.c - Model of the ST7735 panel for the display host tests.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "Crystalfontz128x128_ST7735.h"
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+#include "panel.h"
+
+#define PANEL_ROWS  162
+#define PANEL_COLS  132
+
+uint32_t g_ui32PanelDataBytes;
+uint32_t g_ui32PanelCommands;
+
+static uint16_t g_ppui16Memory[PANEL_ROWS][PANEL_COLS]; // RGB565
+static uint8_t g_ui8Command;
+static uint8_t g_pui8Args[4];
+static uint32_t g_ui32ArgCount;
+static uint32_t g_ui32X0, g_ui32X1, g_ui32Y0, g_ui32Y1; // draw frame
+static uint32_t g_ui32X, g_ui32Y;                         // RAMWR position
+static bool g_bHighByte;                                  // next byte is a pixel MSB
+static uint8_t g_ui8PixelHigh;
+
+void Panel_byte(bool bData, uint8_t ui8Byte)
+{
+    uint32_t a, b;
+
+    if (!bData)
+    {
+        g_ui32PanelCommands++;
+        g_ui8Command = ui8Byte;
+        g_ui32ArgCount = 0;
+        g_bHighByte = true;
+        if (ui8Byte == CM_RAMWR)
+        {
+            g_ui32X = g_ui32X0;
+            g_ui32Y = g_ui32Y0;
+        }
+        return;
+    }
+
+    g_ui32PanelDataBytes++;
+    switch (g_ui8Command)
+    {
+    case CM_CASET:
+    case CM_RASET:
+        if (g_ui32ArgCount >= 4) break;
+        g_pui8Args[g_ui32ArgCount++] = ui8Byte;
+        if (g_ui32ArgCount < 4) break;
+        a = (g_pui8Args[0] << 8) | g_pui8Args[1];
+        b = (g_pui8Args[2] << 8) | g_pui8Args[3];
+        if (g_ui8Command == CM_CASET) { g_ui32X0 = a; g_ui32X1 = b; }
+        else                          { g_ui32Y0 = a; g_ui32Y1 = b; }
+        break;
+    case CM_RAMWR:
+        if (g_bHighByte)
+        {
+            g_ui8PixelHigh = ui8Byte;
+            g_bHighByte = false;
+            break;
+        }
+        g_bHighByte = true;
+        if (g_ui32Y < PANEL_ROWS && g_ui32X < PANEL_COLS)
+            g_ppui16Memory[g_ui32Y][g_ui32X] = (g_ui8PixelHigh << 8) | ui8Byte;
+        if (g_ui32X == g_ui32X1)
+        {
+            g_ui32X = g_ui32X0;
+            g_ui32Y = (g_ui32Y == g_ui32Y1) ? g_ui32Y0 : g_ui32Y + 1;
+        }
+        else
+        {
+            g_ui32X++;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void Panel_resetCounts(void)
+{
+    g_ui32PanelDataBytes = 0;
+    g_ui32PanelCommands = 0;
+}
+
+//*****************************************************************************
+//
+// RGB565 color of frame buffer pixel (x, y), in the order the panel receives
+// it (see HAL_LCD_writePixelBurst()).
+//
+//*****************************************************************************
+static uint16_t Panel_expected(int32_t x, int32_t y)
+{
+    uint16_t v;
+#if LCD_BPP == 16
+    v = Lcd_buffer[y][x];
+#elif LCD_BPP == 8
+    v = Lcd_palette[Lcd_buffer[y][x]];
+#else
+    uint8_t b = Lcd_buffer[y][x >> 1];
+    v = Lcd_palette[(x & 1) ? (b & 15) : (b >> 4)];
+#endif
+#if LCD_SSI_PIXEL_16BIT
+    return v;
+#else
+    return (uint16_t)((v >> 8) | (v << 8)); // frame buffer holds it byte-swapped
+#endif
+}
+
+//*****************************************************************************
+//
+// True if the panel shows the frame buffer (orientation UP: panel column
+// x + 2, row y + 3).
+//
+//*****************************************************************************
+bool Panel_matches(void)
+{
+    int32_t x, y;
+
+    for (y = 0; y < LCD_VERTICAL_MAX; y++)
+    {
+        for (x = 0; x < LCD_HORIZONTAL_MAX; x++)
+        {
+            if (g_ppui16Memory[y + 3][x + 2] != Panel_expected(x, y))
+            {
+                printf("panel (%d, %d) = %04x, frame buffer %04x\n", (int)x, (int)y,
+                       g_ppui16Memory[y + 3][x + 2], Panel_expected(x, y));
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+//*****************************************************************************
+//
+// RGB565 color the panel shows at screen pixel (x, y), orientation UP.
+//
+//*****************************************************************************
+uint16_t Panel_pixel(int32_t x, int32_t y)
+{
+    return g_ppui16Memory[y + 3][x + 2];
+}
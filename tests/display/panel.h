@@ -0,0 +1,26 @@
+//*****************************************************************************
+//
+// panel.h - Model of the ST7735 panel for the display host tests.
+//
+// The HAL stand-ins feed every byte that would go out on the SPI bus to
+// Panel_byte() together with the level of the DC pin. The model decodes
+// CASET/RASET/RAMWR into a copy of the controller's frame memory, which
+// Panel_matches() compares with the driver's frame buffer.
+//
+//*****************************************************************************
+
+#ifndef TESTS_PANEL_H
+#define TESTS_PANEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern uint32_t g_ui32PanelDataBytes;     // bytes sent with DC high
+extern uint32_t g_ui32PanelCommands;      // bytes sent with DC low
+
+extern void Panel_byte(bool bData, uint8_t ui8Byte);
+extern void Panel_resetCounts(void);
+extern bool Panel_matches(void);
+extern uint16_t Panel_pixel(int32_t x, int32_t y);
+
+#endif // TESTS_PANEL_H
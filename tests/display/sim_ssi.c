@@ -0,0 +1,319 @@
+//*****************************************************************************
+//
+// sim_ssi.c - Cycle-level model of the SSI, DC pin and uDMA channel behind
+// the real LCD HAL (HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.c).
+//
+// Time is counted in CPU cycles. Each driverlib call costs a few cycles (the
+// code between them costs nothing, so handler times are lower bounds); a
+// frame takes LCD_SYSTEM_CLOCK / LCD_SSI_CLOCK cycles per bit to shift out,
+// and every byte that leaves the shift register goes to the panel model with
+// the DC level at that moment. The SSI interrupt handler runs from
+// Sim_run() whenever one of its enabled sources is pending:
+//   - TXIM: TX FIFO half full or less, or, with SSICR1.EOT, FIFO empty and
+//     the last bit shifted out,
+//   - DMATXIM: a uDMA control structure finished,
+//   - IntTrigger().
+// The model counts misuse the hardware would not report: disabling the SSI
+// (to change the frame size) or changing DC while a frame is shifting.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "inc/hw_memmap.h"
+#include "inc/hw_ssi.h"
+#include "driverlib/gpio.h"
+#include "driverlib/interrupt.h"
+#include "driverlib/ssi.h"
+#include "driverlib/sysctl.h"
+#include "driverlib/udma.h"
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+#include "panel.h"
+#include "sim_ssi.h"
+
+#define BIT_CYCLES      (LCD_SYSTEM_CLOCK / LCD_SSI_CLOCK)
+#define FIFO_DEPTH      8
+
+uint64_t g_ui64SimCycles;
+uint64_t g_ui64SimIsrCycles;
+uint64_t g_ui64SimIsrMaxCycles;
+uint32_t g_ui32SimIsrCount;
+uint32_t g_ui32SimErrors;
+
+// SSI
+static uint32_t g_ui32CR0 = SSI_CR0_DSS_8, g_ui32CR1, g_ui32Dummy;
+static uint16_t g_pui16Fifo[FIFO_DEPTH];
+static uint32_t g_ui32FifoHead, g_ui32FifoCount;
+static bool g_bShifting;
+static uint16_t g_ui16Shift;
+static uint32_t g_ui32ShiftBits;
+static uint64_t g_ui64ShiftDone;
+static bool g_bTxIntEnabled, g_bDmaTxIntEnabled, g_bDmaTxPending, g_bTriggered;
+static bool g_bDmaRequests;
+static void (*g_pfnIsr)(void);
+static bool g_bInIsr;
+static bool g_bDC = true;
+
+// uDMA: primary and alternate control structures of the SSI TX channel
+static struct
+{
+    const uint8_t *pui8Src;
+    uint32_t ui32Items;
+    uint32_t ui32Mode;
+} g_psDma[2];
+static uint32_t g_ui32DmaItemBytes = 1;
+static uint32_t g_ui32DmaActive;
+static bool g_bDmaEnabled;
+static void *g_pvDmaControlBase;
+
+volatile uint32_t *simReg(uint32_t ui32Address)
+{
+    if (ui32Address == LCD_SSI_BASE + SSI_O_CR0) return &g_ui32CR0;
+    if (ui32Address == LCD_SSI_BASE + SSI_O_CR1) return &g_ui32CR1;
+    return &g_ui32Dummy;
+}
+
+static void Sim_dmaStep(void)
+{
+    if (!g_bDmaEnabled || !g_bDmaRequests) return;
+    while (g_ui32FifoCount < FIFO_DEPTH && g_bDmaEnabled)
+    {
+        uint32_t a = g_ui32DmaActive;
+        uint16_t ui16Item = g_ui32DmaItemBytes == 2 ? *(const uint16_t *)g_psDma[a].pui8Src : *g_psDma[a].pui8Src;
+
+        g_pui16Fifo[(g_ui32FifoHead + g_ui32FifoCount++) % FIFO_DEPTH] = ui16Item;
+        g_psDma[a].pui8Src += g_ui32DmaItemBytes;
+        if (--g_psDma[a].ui32Items) continue;
+
+        // structure done: ping-pong to the other one if it is loaded
+        g_psDma[a].ui32Mode = UDMA_MODE_STOP;
+        g_bDmaTxPending = true;
+        g_ui32DmaActive = a ^ 1;
+        if (g_psDma[g_ui32DmaActive].ui32Mode == UDMA_MODE_STOP) g_bDmaEnabled = false;
+    }
+}
+
+static void Sim_shiftStep(void)
+{
+    if (g_bShifting && g_ui64SimCycles >= g_ui64ShiftDone)
+    {
+        if (g_ui32ShiftBits == 16) Panel_byte(g_bDC, (uint8_t)(g_ui16Shift >> 8));
+        Panel_byte(g_bDC, (uint8_t)g_ui16Shift);
+        g_bShifting = false;
+    }
+    if (!g_bShifting && g_ui32FifoCount && (g_ui32CR1 & SSI_CR1_SSE))
+    {
+        g_ui16Shift = g_pui16Fifo[g_ui32FifoHead];
+        g_ui32FifoHead = (g_ui32FifoHead + 1) % FIFO_DEPTH;
+        g_ui32FifoCount--;
+        g_ui32ShiftBits = (g_ui32CR0 & SSI_CR0_DSS_M) + 1;
+        g_ui64ShiftDone = g_ui64SimCycles + BIT_CYCLES * g_ui32ShiftBits;
+        g_bShifting = true;
+    }
+}
+
+static bool Sim_txInterrupt(void)
+{
+    if (g_ui32CR1 & SSI_CR1_EOT) return g_ui32FifoCount == 0 && !g_bShifting;
+    return g_ui32FifoCount <= FIFO_DEPTH / 2;
+}
+
+// Time spent by the code being run
+static void Sim_advance(uint32_t ui32Cycles)
+{
+    while (ui32Cycles--)
+    {
+        g_ui64SimCycles++;
+        Sim_dmaStep();
+        Sim_shiftStep();
+    }
+}
+
+void Sim_run(uint32_t ui32Cycles)
+{
+    uint64_t ui64Start, ui64Isr;
+
+    while (ui32Cycles--)
+    {
+        Sim_advance(1);
+        if (g_bInIsr || !g_pfnIsr) continue;
+        if (!((g_bTxIntEnabled && Sim_txInterrupt()) ||
+              (g_bDmaTxIntEnabled && g_bDmaTxPending) || g_bTriggered)) continue;
+
+        g_bTriggered = false;
+        g_bInIsr = true;
+        ui64Start = g_ui64SimCycles;
+        g_pfnIsr();
+        ui64Isr = g_ui64SimCycles - ui64Start;
+        g_bInIsr = false;
+        g_ui32SimIsrCount++;
+        g_ui64SimIsrCycles += ui64Isr;
+        if (ui64Isr > g_ui64SimIsrMaxCycles) g_ui64SimIsrMaxCycles = ui64Isr;
+    }
+}
+
+// Busy-wait loops of the code under test let the model run (see sim_while.h)
+void Sim_tick(void)
+{
+    if (!g_bInIsr) Sim_run(1);
+}
+
+void Sim_resetStats(void)
+{
+    g_ui64SimIsrCycles = 0;
+    g_ui64SimIsrMaxCycles = 0;
+    g_ui32SimIsrCount = 0;
+}
+
+//*****************************************************************************
+//
+// driverlib stand-ins
+//
+//*****************************************************************************
+
+void SSIConfigSetExpClk(uint32_t ui32Base, uint32_t ui32SSIClk, uint32_t ui32Protocol,
+                        uint32_t ui32Mode, uint32_t ui32BitRate, uint32_t ui32DataWidth)
+{
+    g_ui32CR0 = ui32DataWidth - 1;
+}
+
+void SSIEnable(uint32_t ui32Base)
+{
+    g_ui32CR1 |= SSI_CR1_SSE;
+}
+
+void SSIDisable(uint32_t ui32Base)
+{
+    if (g_ui32FifoCount || g_bShifting)
+    {
+        printf("SSI disabled while busy at cycle %llu\n", (unsigned long long)g_ui64SimCycles);
+        g_ui32SimErrors++;
+    }
+    g_ui32CR1 &= ~SSI_CR1_SSE;
+}
+
+void SSIDataPut(uint32_t ui32Base, uint32_t ui32Data)
+{
+    while (g_ui32FifoCount == FIFO_DEPTH) Sim_advance(1);
+    SSIDataPutNonBlocking(ui32Base, ui32Data);
+}
+
+int32_t SSIDataPutNonBlocking(uint32_t ui32Base, uint32_t ui32Data)
+{
+    if (g_ui32FifoCount == FIFO_DEPTH) return 0;
+    g_pui16Fifo[(g_ui32FifoHead + g_ui32FifoCount++) % FIFO_DEPTH] = (uint16_t)ui32Data;
+    Sim_advance(4);
+    return 1;
+}
+
+bool SSIBusy(uint32_t ui32Base)
+{
+    Sim_advance(1);
+    return g_ui32FifoCount || g_bShifting;
+}
+
+void SSIIntEnable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    if (ui32IntFlags & SSI_TXFF) g_bTxIntEnabled = true;
+    if (ui32IntFlags & SSI_DMATX) g_bDmaTxIntEnabled = true;
+}
+
+void SSIIntDisable(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    if (ui32IntFlags & SSI_TXFF) g_bTxIntEnabled = false;
+    if (ui32IntFlags & SSI_DMATX) g_bDmaTxIntEnabled = false;
+}
+
+void SSIIntClear(uint32_t ui32Base, uint32_t ui32IntFlags)
+{
+    if (ui32IntFlags & SSI_DMATX) g_bDmaTxPending = false;
+}
+
+uint32_t SSIIntStatus(uint32_t ui32Base, bool bMasked)
+{
+    return (Sim_txInterrupt() ? SSI_TXFF : 0) | (g_bDmaTxPending ? SSI_DMATX : 0);
+}
+
+void SSIIntRegister(uint32_t ui32Base, void (*pfnHandler)(void))
+{
+    g_pfnIsr = pfnHandler;
+}
+
+void SSIDMAEnable(uint32_t ui32Base, uint32_t ui32DMAFlags)
+{
+    g_bDmaRequests = true;
+}
+
+void GPIOPinWrite(uint32_t ui32Port, uint8_t ui8Pins, uint8_t ui8Val)
+{
+    if (ui32Port == LCD_DC_BASE && (ui8Pins & LCD_DC_PIN))
+    {
+        if (g_bShifting)
+        {
+            printf("DC changed while shifting at cycle %llu\n", (unsigned long long)g_ui64SimCycles);
+            g_ui32SimErrors++;
+        }
+        g_bDC = (ui8Val & LCD_DC_PIN) != 0;
+    }
+    Sim_advance(2);
+}
+
+void GPIOPinTypeSSI(uint32_t ui32Port, uint8_t ui8Pins) {}
+void GPIOPinConfigure(uint32_t ui32PinConfig) {}
+void GPIOPinTypeGPIOOutput(uint32_t ui32Port, uint8_t ui8Pins) {}
+void SysCtlPeripheralEnable(uint32_t ui32Peripheral) {}
+bool SysCtlPeripheralReady(uint32_t ui32Peripheral) { return true; }
+void SysCtlDelay(uint32_t ui32Count) {}
+void IntEnable(uint32_t ui32Interrupt) {}
+void IntDisable(uint32_t ui32Interrupt) {}
+
+void IntTrigger(uint32_t ui32Interrupt)
+{
+    g_bTriggered = true;
+}
+
+void uDMAEnable(void) {}
+void uDMAControlBaseSet(void *pControlTable) { g_pvDmaControlBase = pControlTable; }
+void *uDMAControlBaseGet(void) { return g_pvDmaControlBase; }
+void uDMAChannelAssign(uint32_t ui32Mapping) {}
+
+void uDMAChannelAttributeEnable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    if (ui32Attr & UDMA_ATTR_ALTSELECT) g_ui32DmaActive = 1;
+}
+
+void uDMAChannelAttributeDisable(uint32_t ui32ChannelNum, uint32_t ui32Attr)
+{
+    if (ui32Attr & UDMA_ATTR_ALTSELECT) g_ui32DmaActive = 0;
+}
+
+void uDMAChannelControlSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Control)
+{
+    g_ui32DmaItemBytes = (ui32Control & UDMA_SIZE_16) == UDMA_SIZE_16 ? 2 : 1;
+}
+
+void uDMAChannelTransferSet(uint32_t ui32ChannelStructIndex, uint32_t ui32Mode,
+                            void *pvSrcAddr, void *pvDstAddr, uint32_t ui32TransferSize)
+{
+    uint32_t a = (ui32ChannelStructIndex & UDMA_ALT_SELECT) ? 1 : 0;
+
+    g_psDma[a].pui8Src = (const uint8_t *)pvSrcAddr;
+    g_psDma[a].ui32Items = ui32TransferSize;
+    g_psDma[a].ui32Mode = ui32Mode;
+}
+
+void uDMAChannelEnable(uint32_t ui32ChannelNum)
+{
+    g_bDmaEnabled = true;
+}
+
+bool uDMAChannelIsEnabled(uint32_t ui32ChannelNum)
+{
+    return g_bDmaEnabled;
+}
+
+uint32_t uDMAChannelModeGet(uint32_t ui32ChannelStructIndex)
+{
+    return g_psDma[(ui32ChannelStructIndex & UDMA_ALT_SELECT) ? 1 : 0].ui32Mode;
+}
@@ -0,0 +1,28 @@
+//*****************************************************************************
+//
+// sim_ssi.h - Cycle-level model of the SSI, DC pin and uDMA channel behind
+// the real LCD HAL (see sim_ssi.c).
+//
+//*****************************************************************************
+
+#ifndef TESTS_SIM_SSI_H
+#define TESTS_SIM_SSI_H
+
+#include <stdint.h>
+
+extern uint64_t g_ui64SimCycles;        // CPU cycles since reset
+extern uint64_t g_ui64SimIsrCycles;     // cycles spent in the SSI interrupt handler
+extern uint64_t g_ui64SimIsrMaxCycles;  // longest single run of the handler
+extern uint32_t g_ui32SimIsrCount;      // handler runs
+extern uint32_t g_ui32SimErrors;        // SSI misuse detected by the model
+
+// Lets ui32Cycles CPU cycles pass in the main loop, running the SSI
+// interrupt handler whenever it is pending
+extern void Sim_run(uint32_t ui32Cycles);
+
+// One cycle of Sim_run() from a busy-wait loop (see sim_while.h)
+extern void Sim_tick(void);
+
+extern void Sim_resetStats(void);
+
+#endif // TESTS_SIM_SSI_H
@@ -0,0 +1,18 @@
+//*****************************************************************************
+//
+// sim_while.h - Forced into the display driver when it runs on sim_ssi.c.
+//
+// The driver busy-waits on flags that the SSI interrupt handler changes
+// (e.g. while (Lcd_flushBusy);). On the host nothing else advances the
+// model, so every loop condition first lets one cycle pass.
+//
+//*****************************************************************************
+
+#ifndef TESTS_SIM_WHILE_H
+#define TESTS_SIM_WHILE_H
+
+extern void Sim_tick(void);
+
+#define while(cond) while (Sim_tick(), (cond))
+
+#endif // TESTS_SIM_WHILE_H
@@ -0,0 +1,125 @@
+//*****************************************************************************
+//
+// test_async_flush.c - Interrupt-driven (LCD_FLUSH_ASYNC) flush on the SSI
+// model.
+//
+// Runs the driver and the real HAL on sim_ssi.c. Built twice: with the CPU
+// refilling the TX FIFO from its interrupt, and with LCD_USE_UDMA. Checks
+// that
+//   - the asynchronous flush returns right away and pfnDone runs once the
+//     panel shows the frame buffer,
+//   - the SSI is never reconfigured and DC never changes while a frame is
+//     shifting,
+//   - the interrupt handler never waits for the FIFO to drain: no run of it
+//     is longer than sending a command byte plus one FIFO refill,
+//   - drawing into a row the flush has not sent yet waits for it, and
+//     drawing into a row already sent does not.
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Crystalfontz128x128_ST7735.h"
+#include "HAL_EK_TM4C1294XL_Crystalfontz128x128_ST7735.h"
+#include "panel.h"
+#include "sim_ssi.h"
+#include "check.h"
+
+#define BIT_CYCLES          (LCD_SYSTEM_CLOCK / LCD_SSI_CLOCK)
+#define FULL_FRAME_BITS     (LCD_HORIZONTAL_MAX * LCD_VERTICAL_MAX * 16)
+
+// Command byte shifted out, plus some cycles per driverlib call to refill
+// half the FIFO; draining a full FIFO of 16-bit frames takes 8 * 16 bit times
+#define ISR_MAX_CYCLES      (8 * BIT_CYCLES + 300)
+
+static const tDisplay *g_psDisplay = &g_sCrystalfontz128x128;
+static uint32_t g_ui32Done;
+
+static void onFlushDone(void)
+{
+    g_ui32Done++;
+}
+
+static void waitFlush(void)
+{
+    while (Crystalfontz128x128_IsFlushBusy()) Sim_run(100);
+}
+
+static void fill(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint32_t ui32Color)
+{
+    tRectangle sRect = { x0, y0, x1, y1 };
+    g_psDisplay->pfnRectFill(0, &sRect, ui32Color);
+}
+
+int main(void)
+{
+    uint64_t ui64Start, ui64Returned;
+
+    Crystalfontz128x128_Init();
+    Crystalfontz128x128_SetOrientation(LCD_ORIENTATION_UP);
+    CHECK(Panel_matches());
+
+    // blocking full frame, for reference
+    Crystalfontz128x128_Invalidate();
+    ui64Start = g_ui64SimCycles;
+    g_psDisplay->pfnFlush(0);
+    CHECK(g_ui64SimCycles - ui64Start >= (uint64_t)(FULL_FRAME_BITS - 8 * 16) * BIT_CYCLES); // FIFO may still be full
+    CHECK(Panel_matches());
+
+    // asynchronous full frame
+    Crystalfontz128x128_SetFlushMode(LCD_FLUSH_ASYNC, onFlushDone);
+    fill(0, 0, 127, 127, 0x1234);
+    Sim_resetStats();
+    ui64Start = g_ui64SimCycles;
+    g_psDisplay->pfnFlush(0);
+    ui64Returned = g_ui64SimCycles - ui64Start;
+    CHECK(ui64Returned < 1000);
+    CHECK(Crystalfontz128x128_IsFlushBusy());
+    waitFlush();
+    CHECK_EQ(g_ui32Done, 1);
+    CHECK(Panel_matches());
+    CHECK(g_ui64SimIsrMaxCycles <= ISR_MAX_CYCLES);
+    printf("async full frame: returned after %llu cycles, done after %llu, "
+           "%u interrupts, %llu cycles in the handler (longest %llu)\n",
+           (unsigned long long)ui64Returned, (unsigned long long)(g_ui64SimCycles - ui64Start),
+           (unsigned)g_ui32SimIsrCount, (unsigned long long)g_ui64SimIsrCycles,
+           (unsigned long long)g_ui64SimIsrMaxCycles);
+
+    // several windows, then nothing to send
+    fill(10, 10, 50, 20, 0x1111);
+    fill(60, 100, 70, 110, 0x2222);
+    fill(0, 127, 127, 127, 0x3333);
+    Sim_resetStats();
+    Panel_resetCounts();
+    g_psDisplay->pfnFlush(0);
+    waitFlush();
+    CHECK_EQ(g_ui32Done, 2);
+    CHECK_EQ(g_ui32PanelCommands, 3 * 3);
+    CHECK(Panel_matches());
+    CHECK(g_ui64SimIsrMaxCycles <= ISR_MAX_CYCLES);
+    g_psDisplay->pfnFlush(0);
+    CHECK_EQ(g_ui32Done, 3);
+
+    // drawing while a flush is in flight
+#if !LCD_DOUBLE_BUFFER
+    fill(0, 0, 127, 127, 0x4444);
+    g_psDisplay->pfnFlush(0);
+    ui64Start = g_ui64SimCycles;
+    g_psDisplay->pfnPixelDraw(0, 5, 100, 0x5555);   // row not sent yet: waits
+    CHECK(g_ui64SimCycles - ui64Start >= (uint64_t)100 * LCD_HORIZONTAL_MAX * 16 * BIT_CYCLES);
+    CHECK(Crystalfontz128x128_IsFlushBusy());
+    ui64Start = g_ui64SimCycles;
+    g_psDisplay->pfnPixelDraw(0, 5, 5, 0x6666);     // row already sent: no wait
+    CHECK(g_ui64SimCycles - ui64Start < 1000);
+    waitFlush();
+    CHECK(Panel_pixel(5, 100) == Panel_pixel(6, 100)); // neither pixel is on the panel yet
+    CHECK(Panel_pixel(5, 5) == Panel_pixel(6, 5));
+    g_psDisplay->pfnFlush(0);
+    waitFlush();
+    CHECK(Panel_matches());
+    CHECK_EQ(g_ui32Done, 5);
+#endif
+
+    CHECK_EQ(g_ui32SimErrors, 0);
+    return CHECK_RESULT();
+}
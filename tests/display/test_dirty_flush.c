@@ -0,0 +1,114 @@
+//*****************************************************************************
+//
+// test_dirty_flush.c - Bytes sent by the dirty-rectangle flush.
+//
+// Runs the driver against fake_hal.c and counts the data bytes handed to the
+// HAL for each flush: a full frame after Crystalfontz128x128_Invalidate(),
+// nothing when nothing was drawn, and only the bounding rectangle of what
+// each primitive touched otherwise. After every flush the panel model must
+// show the frame buffer. Built once per frame buffer format (LCD_BPP).
+//
+//*****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Crystalfontz128x128_ST7735.h"
+#include "panel.h"
+#include "check.h"
+
+#define WINDOW_BYTES    8   // CASET and RASET parameters
+#define PIXEL_BYTES     2
+
+// Pixels sent for columns x0..x1 of a row: at 4 bpp the dirty spans are
+// widened to whole frame buffer bytes
+#if LCD_BPP == 4
+#define SPAN(x0, x1)    ((((x1) | 1) - ((x0) & ~1)) + 1)
+#else
+#define SPAN(x0, x1)    ((x1) - (x0) + 1)
+#endif
+
+static const tDisplay *g_psDisplay = &g_sCrystalfontz128x128;
+
+static void flush(void)
+{
+    Panel_resetCounts();
+    g_psDisplay->pfnFlush(0);
+}
+
+int main(void)
+{
+    tRectangle sRect;
+    uint8_t pui8Image[2] = { 0xaa, 0x55 };
+    uint32_t pui32Palette[2] = { 0x1111, 0x2222 };
+
+    Crystalfontz128x128_Init();
+    Crystalfontz128x128_SetOrientation(LCD_ORIENTATION_UP);
+
+    // whole frame
+    Crystalfontz128x128_Invalidate();
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, WINDOW_BYTES + LCD_HORIZONTAL_MAX * LCD_VERTICAL_MAX * PIXEL_BYTES);
+    CHECK_EQ(g_ui32PanelCommands, 3);
+    CHECK(Panel_matches());
+
+    // nothing drawn
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, 0);
+    CHECK_EQ(g_ui32PanelCommands, 0);
+
+    // one pixel
+    g_psDisplay->pfnPixelDraw(0, 3, 3, 0xffff);
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, WINDOW_BYTES + SPAN(3, 3) * PIXEL_BYTES);
+    CHECK(Panel_matches());
+
+    // rectangle, columns 60..100 of rows 50..57
+    sRect.i16XMin = 60;
+    sRect.i16YMin = 50;
+    sRect.i16XMax = 100;
+    sRect.i16YMax = 57;
+    g_psDisplay->pfnRectFill(0, &sRect, 0x1234);
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, WINDOW_BYTES + SPAN(60, 100) * 8 * PIXEL_BYTES);
+    CHECK(Panel_matches());
+
+    // vertical and horizontal lines in separate rows: two windows
+    g_psDisplay->pfnLineDrawV(0, 90, 10, 20, 0xabcd);
+    g_psDisplay->pfnLineDrawH(0, 5, 120, 90, 0x5555);
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, 2 * WINDOW_BYTES + (SPAN(90, 90) * 11 + SPAN(5, 120)) * PIXEL_BYTES);
+    CHECK_EQ(g_ui32PanelCommands, 2 * 3);
+    CHECK(Panel_matches());
+
+    // 16 pixels of a 1 bpp image
+    g_psDisplay->pfnPixelDrawMultiple(0, 7, 60, 0, 16, 1, pui8Image, (const uint8_t *)pui32Palette);
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, WINDOW_BYTES + SPAN(7, 22) * PIXEL_BYTES);
+    CHECK(Panel_matches());
+
+    // overlapping spans of consecutive rows merge into their bounding rectangle
+    sRect.i16XMin = 10;
+    sRect.i16YMin = 100;
+    sRect.i16XMax = 19;
+    sRect.i16YMax = 104;
+    g_psDisplay->pfnRectFill(0, &sRect, 0x2222);
+    sRect.i16XMin = 15;
+    sRect.i16YMin = 105;
+    sRect.i16XMax = 29;
+    sRect.i16YMax = 109;
+    g_psDisplay->pfnRectFill(0, &sRect, 0x3333);
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, WINDOW_BYTES + SPAN(10, 29) * 10 * PIXEL_BYTES);
+    CHECK(Panel_matches());
+
+    // the same again through the asynchronous path
+    Crystalfontz128x128_SetFlushMode(LCD_FLUSH_ASYNC, 0);
+    g_psDisplay->pfnRectFill(0, &sRect, 0x4444);
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, WINDOW_BYTES + SPAN(15, 29) * 5 * PIXEL_BYTES);
+    CHECK(Panel_matches());
+    flush();
+    CHECK_EQ(g_ui32PanelDataBytes, 0);
+
+    return CHECK_RESULT();
+}
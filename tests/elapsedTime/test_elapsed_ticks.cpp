@@ -0,0 +1,110 @@
+// Prueba en host de elapsedTicks<U> sobre un reloj MANUAL.
+//
+// Las comparaciones de elapsedTicks pasan el umbral a ticks en lugar de
+// convertir los ticks a unidades. Se comprueba que >=, >, < y <= dan
+// exactamente lo mismo que comparar (uint64_t)em, que trunca, justo en los
+// bordes de cada unidad (n * ticksPorUnidad - 1, n * ticksPorUnidad, + 1) y
+// con avances aleatorios, para s, ms y us, leyendo el Timer o un
+// TimeSnapshot.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include "check.h"
+#include "elapsedTime.h"
+
+static const uint32_t SYSCLK = 120000000;
+
+// ---- driverlib simulado (MANUAL no lo usa; solo enlaza timerLib.cpp) --------
+
+extern "C" {
+void SysCtlPeripheralEnable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+void TimerClockSourceSet(uint32_t, uint32_t) {}
+void TimerConfigure(uint32_t, uint32_t) {}
+void TimerEnable(uint32_t, uint32_t) {}
+void TimerDisable(uint32_t, uint32_t) {}
+void TimerLoadSet(uint32_t, uint32_t, uint32_t) {}
+void TimerLoadSet64(uint32_t, uint64_t) {}
+uint32_t TimerValueGet(uint32_t, uint32_t) { return 0; }
+uint64_t TimerValueGet64(uint32_t) { return 0; }
+void TimerIntClear(uint32_t, uint32_t) {}
+void TimerIntEnable(uint32_t, uint32_t) {}
+uint32_t TimerIntStatus(uint32_t, bool) { return 0; }
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void)) {}
+bool IntMasterDisable(void) { return false; }
+bool IntMasterEnable(void) { return true; }
+}
+
+// ---------------------------------------------------------------------------
+
+static unsigned long s_mismatches;
+
+// Cada comparación contra el valor convertido, para umbrales alrededor de él
+template <uint32_t U>
+static void checkAgainstValue(const elapsedTicks<U>& em)
+{
+    uint64_t v = em;
+    for (uint64_t n = v ? v - 1 : 0; n <= v + 1; n++) {
+        bool ok = (em >= n) == (v >= n) && (em > n) == (v > n) &&
+                  (em < n)  == (v < n)  && (em <= n) == (v <= n);
+        if (!ok && s_mismatches++ < 10) {
+            printf("U = %u, ticks = %llu, valor = %llu, umbral = %llu\n", U,
+                   (unsigned long long)em.ticks(), (unsigned long long)v,
+                   (unsigned long long)n);
+        }
+    }
+}
+
+// Recorre los bordes de las primeras unidades y luego avances aleatorios
+template <uint32_t U>
+static void checkUnits(Timer& clock, TimeSnapshot* snap)
+{
+    const uint64_t tpu = SYSCLK / U;
+    std::mt19937_64 rng(U);
+    if (snap) snap->update();
+    elapsedTicks<U> em = snap ? elapsedTicks<U>(*snap) : elapsedTicks<U>(clock);
+
+    uint64_t elapsed = 0;
+    for (uint64_t n = 1; n <= 50; n++) {
+        const uint64_t edges[] = { n * tpu - 1, n * tpu, n * tpu + 1 };
+        for (uint64_t t : edges) {
+            clock.advance(t - elapsed);
+            elapsed = t;
+            if (snap) snap->update();
+            CHECK_EQ((uint64_t)em, t / tpu);
+            checkAgainstValue(em);
+        }
+    }
+    for (int i = 0; i < 100000; i++) {
+        clock.advance(rng() % (3 * tpu));
+        if (snap) snap->update();
+        checkAgainstValue(em);
+    }
+}
+
+int main()
+{
+    Timer clock;
+    CHECK(clock.begin(SYSCLK, Timer::MANUAL));
+    TimeSnapshot now(clock);
+
+    checkUnits<1u>(clock, nullptr);
+    checkUnits<1000u>(clock, nullptr);
+    checkUnits<1000000u>(clock, nullptr);
+    checkUnits<1000u>(clock, &now);
+    checkUnits<1000000u>(clock, &now);
+    CHECK_EQ(s_mismatches, 0);
+
+    // '> 20' se cumple con 21 ms enteros, no un tick después de los 20
+    now.update();
+    elapsedTickMillis em(now);
+    clock.advance(20 * (SYSCLK / 1000) + 1);
+    now.update();
+    CHECK(em >= 20 && !(em > 20) && em <= 20);
+    clock.advance(SYSCLK / 1000 - 1);
+    now.update();
+    CHECK(em > 20 && !(em <= 20));
+
+    return CHECK_RESULT();
+}
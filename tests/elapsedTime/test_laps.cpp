@@ -0,0 +1,124 @@
+// Prueba en host de SplitRing, LapStats y LapRecorder.
+//
+// El productor marca ráfagas de 0..24 splits crecientes y el consumidor saca
+// ráfagas de 0..24 vueltas, así que la cola de 16 se llena, se vacía y da
+// la vuelta millones de veces. Se comprueba que
+//   - cada push() falla exactamente con la cola llena y dropped() lo cuenta,
+//   - las vueltas salen en orden, numeradas, con lap = split - split anterior
+//     aceptado,
+//   - min/max son exactos y media y varianza coinciden con las calculadas
+//     con sumas enteras exactas (error relativo < 1e-9),
+//   - reset() empieza de cero.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <random>
+#include <deque>
+#include "check.h"
+#include "laps.h"
+
+typedef unsigned __int128 u128;
+
+// Media y varianza muestral exactas a partir de n, suma y suma de cuadrados
+static double exactMean(uint64_t n, u128 sum) { return (double)sum / (double)n; }
+
+static double exactVariance(uint64_t n, u128 sum, u128 sumSq)
+{
+    if (n < 2) return 0.0;
+    u128 num = (u128)n * sumSq - sum * sum;  // n * sum(x^2) - (sum x)^2 >= 0
+    return (double)num / ((double)n * (double)(n - 1));
+}
+
+static bool close(double got, double want)
+{
+    return fabs(got - want) <= 1e-9 * fabs(want) + 1e-9;
+}
+
+int main()
+{
+    std::mt19937_64 rng(14);
+
+    // SplitRing: llena, descarta y conserva el orden tras dar la vuelta
+    {
+        SplitRing<8> ring;
+        uint64_t v;
+        CHECK(!ring.pop(v));
+        for (uint64_t i = 0; i < 10; i++) CHECK_EQ(ring.push(i), i < 8);
+        CHECK_EQ(ring.size(), 8);
+        CHECK_EQ(ring.dropped(), 2);
+        for (uint64_t i = 0; i < 5; i++) CHECK(ring.pop(v) && v == i);
+        for (uint64_t i = 10; i < 15; i++) CHECK(ring.push(i));
+        const uint64_t expected[] = { 5, 6, 7, 10, 11, 12, 13, 14 };
+        for (uint64_t e : expected) CHECK(ring.pop(v) && v == e);
+        CHECK(!ring.pop(v));
+        CHECK_EQ(ring.dropped(), 2);
+    }
+
+    // Millones de splits por LapRecorder<16>
+    LapRecorder<16> laps;
+    std::deque<uint64_t> pending;            // splits aceptados sin sacar
+    uint64_t split = 0, lastSplit = 0, pushes = 0, drops = 0;
+    uint64_t n = 0, minLap = 0, maxLap = 0;
+    u128 sum = 0, sumSq = 0;
+    unsigned long bad = 0;
+    while (pushes < 6000000) {
+        for (uint32_t k = rng() % 25; k > 0; k--, pushes++) {
+            // Vueltas de 1 tick a ~8 s a 120 MHz, alguna muy larga
+            split += rng() % 64 == 0 ? rng() % (1ull << 40) : 1 + rng() % 1000000000ull;
+            bool full = pending.size() == 16;
+            if (laps.split(split) == full) bad++;
+            if (full) drops++;
+            else pending.push_back(split);
+        }
+        if (laps.dropped() != drops) bad++;
+
+        LapRecorder<16>::Lap lap;
+        for (uint32_t k = rng() % 25; k > 0; k--) {
+            bool got = laps.poll(lap);
+            if (got != !pending.empty()) { bad++; break; }
+            if (!got) break;
+            uint64_t want = pending.front();
+            pending.pop_front();
+            n++;
+            uint64_t len = want - lastSplit;
+            lastSplit = want;
+            if (lap.number != n || lap.split != want || lap.lap != len) bad++;
+            if (n == 1 || len < minLap) minLap = len;
+            if (n == 1 || len > maxLap) maxLap = len;
+            sum += len;
+            sumSq += (u128)len * len;
+        }
+
+        const LapStats& s = laps.stats();
+        if (s.count() != n || s.min() != minLap || s.max() != maxLap ||
+            (n && (!close(s.mean(), exactMean(n, sum)) ||
+                   !close(s.variance(), exactVariance(n, sum, sumSq))))) {
+            if (bad++ < 5) {
+                printf("%llu vueltas: media %.17g / %.17g, varianza %.17g / %.17g\n",
+                       (unsigned long long)n, s.mean(), n ? exactMean(n, sum) : 0.0,
+                       s.variance(), exactVariance(n, sum, sumSq));
+            }
+        }
+    }
+    CHECK_EQ(bad, 0);
+    CHECK(n > 1000000);
+    CHECK(drops > 100000);
+    CHECK_EQ(laps.count(), n);
+    CHECK(close(laps.stats().stddev(), sqrt(exactVariance(n, sum, sumSq))));
+
+    // reset(): la siguiente vuelta se mide desde 0
+    laps.reset();
+    LapRecorder<16>::Lap lap;
+    CHECK(!laps.poll(lap));
+    CHECK_EQ(laps.stats().count(), 0);
+    CHECK(laps.split(500));
+    CHECK(laps.split(800));
+    CHECK(laps.poll(lap) && lap.number == 1 && lap.lap == 500);
+    CHECK(laps.poll(lap) && lap.number == 2 && lap.lap == 300);
+    CHECK_EQ(laps.stats().min(), 300);
+    CHECK_EQ(laps.stats().max(), 500);
+    CHECK(laps.stats().mean() == 400.0 && laps.stats().variance() == 20000.0);
+
+    return CHECK_RESULT();
+}
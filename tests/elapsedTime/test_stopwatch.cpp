@@ -0,0 +1,171 @@
+// Prueba en host de Stopwatch sobre un reloj MANUAL.
+//
+// El loop se simula con bloqueos aleatorios de 0..250 ms (y alguno de
+// segundos), en ticks sueltos, no en ms enteros. Entre bloqueos hay flancos
+// al azar: start()/stop()/toggle() en el tick actual, start(tick)/stop(tick)
+// con un tick capturado antes del último bloqueo (como en la ISR del botón)
+// y reset(). Un total de referencia suma solo los tramos en marcha. Se
+// comprueba en cada vuelta, durante más de 3.5 h simuladas por frecuencia,
+// que
+//   - elapsedTicks() y elapsedTicksAt() son exactamente el total,
+//   - elapsedMillis() es el total en ms truncado,
+//   - time() reparte esos ms en H:M:S:ms,
+// y que con cientos de horas acumuladas no hay desborde. Los ms salen del
+// recíproco del Timer, exacto con relojes de MHz enteros. toTime() se
+// compara además con la división para todo resto de una hora y para ms al
+// azar de 64 bits.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include "check.h"
+#include "stopwatch.h"
+
+// ---- driverlib simulado (MANUAL no lo usa; solo enlaza timerLib.cpp) --------
+
+extern "C" {
+void SysCtlPeripheralEnable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+void TimerClockSourceSet(uint32_t, uint32_t) {}
+void TimerConfigure(uint32_t, uint32_t) {}
+void TimerEnable(uint32_t, uint32_t) {}
+void TimerDisable(uint32_t, uint32_t) {}
+void TimerLoadSet(uint32_t, uint32_t, uint32_t) {}
+void TimerLoadSet64(uint32_t, uint64_t) {}
+uint32_t TimerValueGet(uint32_t, uint32_t) { return 0; }
+uint64_t TimerValueGet64(uint32_t) { return 0; }
+void TimerIntClear(uint32_t, uint32_t) {}
+void TimerIntEnable(uint32_t, uint32_t) {}
+uint32_t TimerIntStatus(uint32_t, bool) { return 0; }
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void)) {}
+bool IntMasterDisable(void) { return false; }
+bool IntMasterEnable(void) { return true; }
+}
+
+// ---------------------------------------------------------------------------
+
+static unsigned long s_mismatches;
+
+// El cronómetro contra el total de referencia (ticks)
+static void checkAgainst(const Stopwatch& sw, Timer& clock, uint64_t truth)
+{
+    const uint64_t hz = clock.clockHz();
+    uint64_t ms = (uint64_t)((unsigned __int128)truth * 1000u / hz);
+    Stopwatch::Time t = sw.time();
+    uint64_t fromTime = (uint64_t)t.hours * 3600000u + t.minutes * 60000u + t.seconds * 1000u + t.millis;
+    bool ok = sw.elapsedTicks() == truth && sw.elapsedTicksAt(clock.ticks()) == truth &&
+              sw.elapsedMillis() == ms && fromTime == ms &&
+              t.minutes < 60 && t.seconds < 60 && t.millis < 1000;
+    if (!ok && s_mismatches++ < 10) {
+        printf("hz %llu: total %llu ticks, elapsedTicks %llu, %llu ms, elapsedMillis %llu, time %u:%u:%u.%u\n",
+               (unsigned long long)hz, (unsigned long long)truth, (unsigned long long)sw.elapsedTicks(),
+               (unsigned long long)ms, (unsigned long long)sw.elapsedMillis(),
+               t.hours, t.minutes, t.seconds, t.millis);
+    }
+}
+
+static void runStalls(uint32_t hz, std::mt19937_64& rng)
+{
+    Timer clock;
+    CHECK(clock.begin(hz, Timer::MANUAL));
+    clock.advance(rng() % ((uint64_t)hz * 100));   // origen arbitrario
+    Stopwatch sw(clock);
+
+    const uint64_t tpms = hz / 1000;
+    uint64_t truth = 0, simulated = 0;
+    bool running = false;
+    unsigned long edges = 0;
+    while (simulated < (uint64_t)hz * 3600 * 4) {
+        // Flanco capturado antes del bloqueo y aplicado después
+        bool captured = rng() % 8 == 0;
+        uint64_t capturedAt = clock.ticks();
+
+        uint64_t stall = rng() % 64 == 0 ? rng() % ((uint64_t)hz * 5) : rng() % (250 * tpms + 1);
+        clock.advance(stall);
+        simulated += stall;
+        if (running) truth += stall;
+
+        uint64_t now = clock.ticks();
+        switch (rng() % 16) {
+        case 0:
+            if (captured) {
+                sw.start(capturedAt);
+                if (!running) truth += now - capturedAt;
+            } else {
+                sw.start();
+            }
+            running = true;
+            edges++;
+            break;
+        case 1:
+            if (captured) {
+                sw.stop(capturedAt);
+                if (running) truth -= now - capturedAt;
+            } else {
+                sw.stop();
+            }
+            running = false;
+            edges++;
+            break;
+        case 2:
+            sw.toggle();
+            running = !running;
+            edges++;
+            break;
+        case 3:
+            if (rng() % 8 == 0) {
+                sw.reset();
+                truth = 0;
+            }
+            break;
+        default:
+            break;
+        }
+        if (sw.isRunning() != running) s_mismatches++;
+        checkAgainst(sw, clock, truth);
+    }
+    CHECK(edges > 10000);
+
+    // Cientos de horas en marcha
+    sw.reset();
+    sw.start();
+    truth = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t stall = rng() % ((uint64_t)hz * 3600);
+        clock.advance(stall);
+        truth += stall;
+        checkAgainst(sw, clock, truth);
+    }
+    CHECK(sw.time().hours > 400);
+}
+
+int main()
+{
+    std::mt19937_64 rng(13);
+    const uint32_t clocks[] = { 120000000u, 16000000u, 25000000u, 80000000u };
+    for (uint32_t hz : clocks) runStalls(hz, rng);
+    CHECK_EQ(s_mismatches, 0);
+
+    // toTime() con recíprocos contra la división
+    unsigned long timeMismatches = 0;
+    for (uint64_t i = 0; i < 3600000 + 2000000; i++) {
+        uint64_t ms = i < 3600000 ? i : (i % 3 == 0 ? rng() : rng() >> (rng() % 64));
+        if (i >= 3600000 && i < 3700000) ms = (ms % 100000) * 3600000 + (rng() % 3) - 1;
+        Stopwatch::Time t = Stopwatch::toTime(ms);
+        if (t.hours != (uint32_t)(ms / 3600000) || t.minutes != ms / 60000 % 60 ||
+            t.seconds != ms / 1000 % 60 || t.millis != ms % 1000) {
+            if (timeMismatches++ < 5) printf("toTime(%llu) = %u:%u:%u.%u\n", (unsigned long long)ms,
+                                             t.hours, t.minutes, t.seconds, t.millis);
+        }
+    }
+    CHECK_EQ(timeMismatches, 0);
+
+    // Sin reloj (clockHz() == 0) elapsedMillis() es 0 en lugar de dividir por 0
+    {
+        Timer none;
+        Stopwatch sw(none);
+        CHECK_EQ(sw.toMillis(12345), 0);
+    }
+
+    return CHECK_RESULT();
+}
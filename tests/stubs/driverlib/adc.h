@@ -0,0 +1,46 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define ADC_CTL_CH0 0
+#define ADC_CTL_CH1 1
+#define ADC_CTL_CH2 2
+#define ADC_CTL_CH3 3
+#define ADC_CTL_CH4 4
+#define ADC_CTL_CH5 5
+#define ADC_CTL_CH6 6
+#define ADC_CTL_CH7 7
+#define ADC_CTL_CH8 8
+#define ADC_CTL_CH9 9
+#define ADC_CTL_CH10 10
+#define ADC_CTL_CH11 11
+#define ADC_CTL_CH12 12
+#define ADC_CTL_CH13 13
+#define ADC_CTL_CH14 14
+#define ADC_CTL_CH15 15
+#define ADC_CTL_CH16 16
+#define ADC_CTL_CH17 17
+#define ADC_CTL_CH18 18
+#define ADC_CTL_CH19 19
+#define ADC_CTL_CH20 20
+#define ADC_CTL_CH21 21
+#define ADC_CTL_CH22 22
+#define ADC_CTL_CH23 23
+#define ADC_CTL_TS 0x80
+#define ADC_CTL_IE 0x40
+#define ADC_CTL_END 0x20
+#define ADC_TRIGGER_PROCESSOR 0
+void ADCSequenceConfigure(uint32_t,uint32_t,uint32_t,uint32_t);
+void ADCSequenceStepConfigure(uint32_t,uint32_t,uint32_t,uint32_t);
+void ADCSequenceEnable(uint32_t,uint32_t);
+void ADCSequenceDisable(uint32_t,uint32_t);
+void ADCIntClear(uint32_t,uint32_t);
+bool ADCIntStatus(uint32_t,uint32_t,bool);
+void ADCProcessorTrigger(uint32_t,uint32_t);
+int32_t ADCSequenceDataGet(uint32_t,uint32_t,uint32_t*);
+void GPIOPinTypeADC(uint32_t,uint8_t);
+#ifdef __cplusplus
+}
+#endif
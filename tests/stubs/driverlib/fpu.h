@@ -0,0 +1,9 @@
+#pragma once
+#ifdef __cplusplus
+extern "C" {
+#endif
+void FPUEnable(void);
+void FPULazyStackingEnable(void);
+#ifdef __cplusplus
+}
+#endif
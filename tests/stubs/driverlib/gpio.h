@@ -0,0 +1,37 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define GPIO_PIN_0 1
+#define GPIO_PIN_1 2
+#define GPIO_PIN_2 4
+#define GPIO_PIN_3 8
+#define GPIO_PIN_4 16
+#define GPIO_PIN_5 32
+#define GPIO_PIN_6 64
+#define GPIO_PIN_7 128
+#define GPIO_STRENGTH_2MA 1
+#define GPIO_PIN_TYPE_STD_WPU 1
+#define GPIO_PIN_TYPE_STD_WPD 2
+#define GPIO_PIN_TYPE_STD 3
+#define GPIO_BOTH_EDGES 1
+#define GPIO_RISING_EDGE 2
+#define GPIO_FALLING_EDGE 3
+void GPIOPinTypeSSI(uint32_t, uint8_t);
+void GPIOPinConfigure(uint32_t);
+void GPIOPinTypeGPIOOutput(uint32_t, uint8_t);
+void GPIOPinTypeGPIOInput(uint32_t, uint8_t);
+void GPIOPinWrite(uint32_t, uint8_t, uint8_t);
+int32_t GPIOPinRead(uint32_t, uint8_t);
+void GPIOPadConfigSet(uint32_t, uint8_t, uint32_t, uint32_t);
+void GPIOIntDisable(uint32_t, uint32_t);
+void GPIOIntEnable(uint32_t, uint32_t);
+void GPIOIntClear(uint32_t, uint32_t);
+uint32_t GPIOIntStatus(uint32_t, bool);
+void GPIOIntTypeSet(uint32_t, uint8_t, uint32_t);
+void GPIOIntRegister(uint32_t, void (*)(void));
+#ifdef __cplusplus
+}
+#endif
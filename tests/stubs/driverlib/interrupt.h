@@ -0,0 +1,16 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+bool IntMasterEnable(void);
+bool IntMasterDisable(void);
+void IntEnable(uint32_t);
+void IntDisable(uint32_t);
+void IntRegister(uint32_t, void (*)(void));
+void IntTrigger(uint32_t);
+void IntPrioritySet(uint32_t, uint8_t);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,3 @@
+#pragma once
+#define GPIO_PD3_SSI2CLK 1
+#define GPIO_PD1_SSI2XDAT0 2
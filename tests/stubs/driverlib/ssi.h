@@ -0,0 +1,28 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define SSI_FRF_MOTO_MODE_0 0
+#define SSI_MODE_MASTER 0
+#define SSI_TXEOT 0x40
+#define SSI_DMATX 0x20
+#define SSI_TXFF 0x08
+#define SSI_DMA_TX 0x2
+void SSIConfigSetExpClk(uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t);
+void SSIEnable(uint32_t);
+void SSIDisable(uint32_t);
+void SSIDataPut(uint32_t, uint32_t);
+int32_t SSIDataPutNonBlocking(uint32_t, uint32_t);
+bool SSIBusy(uint32_t);
+void SSIIntEnable(uint32_t, uint32_t);
+void SSIIntDisable(uint32_t, uint32_t);
+void SSIIntClear(uint32_t, uint32_t);
+uint32_t SSIIntStatus(uint32_t, bool);
+void SSIIntRegister(uint32_t, void (*)(void));
+void SSIDMAEnable(uint32_t, uint32_t);
+void SSIDMADisable(uint32_t, uint32_t);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define SYSCTL_PERIPH_GPIOA 1
+#define SYSCTL_PERIPH_GPIOD 2
+#define SYSCTL_PERIPH_GPIOH 3
+#define SYSCTL_PERIPH_GPION 4
+#define SYSCTL_PERIPH_GPIOL 5
+#define SYSCTL_PERIPH_SSI2 6
+#define SYSCTL_PERIPH_UDMA 7
+#define SYSCTL_PERIPH_TIMER0 10
+#define SYSCTL_PERIPH_TIMER1 11
+#define SYSCTL_PERIPH_TIMER2 12
+#define SYSCTL_PERIPH_TIMER3 13
+#define SYSCTL_PERIPH_TIMER4 14
+#define SYSCTL_PERIPH_TIMER5 15
+#define SYSCTL_PERIPH_WTIMER0 20
+#define SYSCTL_PERIPH_WTIMER1 21
+#define SYSCTL_PERIPH_WTIMER2 22
+#define SYSCTL_PERIPH_WTIMER3 23
+#define SYSCTL_PERIPH_WTIMER4 24
+#define SYSCTL_PERIPH_WTIMER5 25
+#define SYSCTL_XTAL_25MHZ 0
+#define SYSCTL_OSC_MAIN 0
+#define SYSCTL_USE_PLL 0
+#define SYSCTL_CFG_VCO_480 0
+#define SYSCTL_PERIPH_GPIOB 101
+#define SYSCTL_PERIPH_GPIOC 102
+#define SYSCTL_PERIPH_GPIOE 104
+#define SYSCTL_PERIPH_GPIOF 105
+#define SYSCTL_PERIPH_GPIOG 106
+#define SYSCTL_PERIPH_GPIOJ 108
+#define SYSCTL_PERIPH_GPIOK 109
+#define SYSCTL_PERIPH_GPIOM 111
+#define SYSCTL_PERIPH_GPIOP 113
+#define SYSCTL_PERIPH_GPIOQ 114
+#define SYSCTL_PERIPH_ADC0 200
+#define SYSCTL_PERIPH_ADC1 201
+void SysCtlPeripheralEnable(uint32_t);
+bool SysCtlPeripheralReady(uint32_t);
+void SysCtlDelay(uint32_t);
+uint32_t SysCtlClockFreqSet(uint32_t, uint32_t);
+void SysCtlSleep(void);
+void SysCtlPeripheralSleepEnable(uint32_t);
+void SysCtlPeripheralClockGating(bool);
+#ifdef __cplusplus
+}
+#endif
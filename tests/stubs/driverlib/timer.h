@@ -0,0 +1,35 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define TIMER_A 0xff
+#define TIMER_B 0xff00
+#define TIMER_BOTH 0xffff
+#define TIMER_CLOCK_SYSTEM 0
+#define TIMER_CFG_PERIODIC 0x22
+#define TIMER_CFG_ONE_SHOT 0x21
+#define TIMER_CFG_SPLIT_PAIR 0x04000000
+#define TIMER_CFG_A_ONE_SHOT 0x21
+#define TIMER_CFG_A_CAP_TIME 0x7
+#define TIMER_TIMA_TIMEOUT 0x1
+#define TIMER_TIMA_MATCH 0x10
+#define TIMER_CAPA_EVENT 0x4
+void TimerDisable(uint32_t, uint32_t);
+void TimerEnable(uint32_t, uint32_t);
+void TimerClockSourceSet(uint32_t, uint32_t);
+void TimerConfigure(uint32_t, uint32_t);
+void TimerLoadSet(uint32_t, uint32_t, uint32_t);
+void TimerLoadSet64(uint32_t, uint64_t);
+uint32_t TimerValueGet(uint32_t, uint32_t);
+uint64_t TimerValueGet64(uint32_t);
+void TimerIntEnable(uint32_t, uint32_t);
+void TimerIntDisable(uint32_t, uint32_t);
+void TimerIntClear(uint32_t, uint32_t);
+uint32_t TimerIntStatus(uint32_t, bool);
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void));
+void TimerMatchSet(uint32_t, uint32_t, uint32_t);
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+typedef struct { volatile void *pvSrcEndAddr; volatile void *pvDstEndAddr; volatile uint32_t ui32Control; volatile uint32_t ui32Spare; } tDMAControlTable;
+#define UDMA_CH13_SSI2TX 13
+#define UDMA_PRI_SELECT 0
+#define UDMA_ALT_SELECT 0x20
+#define UDMA_SIZE_8 0
+#define UDMA_SIZE_16 0x11000000
+#define UDMA_SRC_INC_8 0
+#define UDMA_SRC_INC_16 0x04000000
+#define UDMA_SRC_INC_NONE 0x0c000000
+#define UDMA_DST_INC_NONE 0xc0000000
+#define UDMA_ARB_4 0x8000
+#define UDMA_MODE_BASIC 1
+#define UDMA_MODE_PER_SCATTER_GATHER 7
+#define UDMA_MODE_STOP 0
+#define UDMA_MODE_PINGPONG 3
+void *uDMAControlBaseGet(void);
+#define UDMA_ATTR_USEBURST 1
+#define UDMA_ATTR_ALTSELECT 2
+#define UDMA_ATTR_HIGH_PRIORITY 4
+#define UDMA_ATTR_REQMASK 8
+#define UDMA_ATTR_ALL 15
+#define UDMA_CH13_SSI2TX_SEL 13
+void uDMAEnable(void);
+void uDMAControlBaseSet(void *);
+void uDMAChannelAssign(uint32_t);
+void uDMAChannelAttributeDisable(uint32_t, uint32_t);
+void uDMAChannelAttributeEnable(uint32_t, uint32_t);
+void uDMAChannelControlSet(uint32_t, uint32_t);
+void uDMAChannelTransferSet(uint32_t, uint32_t, void *, void *, uint32_t);
+void uDMAChannelEnable(uint32_t);
+void uDMAChannelDisable(uint32_t);
+bool uDMAChannelIsEnabled(uint32_t);
+uint32_t uDMAChannelModeGet(uint32_t);
+uint32_t uDMAChannelSizeGet(uint32_t);
+void uDMAChannelScatterGatherSet(uint32_t, uint32_t, void *, uint32_t);
+#define uDMATaskStructEntry(ui32TransferCount, ui32ItemSize, ui32SrcIncrement, pvSrcAddr, ui32DstIncrement, pvDstAddr, ui32ArbSize, ui32Mode) { (void*)(pvSrcAddr), (void*)(pvDstAddr), (ui32ItemSize)|(ui32SrcIncrement)|(ui32DstIncrement)|(ui32ArbSize)|(ui32Mode)|(((ui32TransferCount)-1)<<4), 0 }
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef __cplusplus
+extern "C" {
+#endif
+typedef struct { int16_t i16XMin; int16_t i16YMin; int16_t i16XMax; int16_t i16YMax; } tRectangle;
+typedef struct
+{
+    int32_t i32Size;
+    void *pvDisplayData;
+    uint16_t ui16Width;
+    uint16_t ui16Height;
+    void (*pfnPixelDraw)(void *pvDisplayData, int32_t i32X, int32_t i32Y, uint32_t ui32Value);
+    void (*pfnPixelDrawMultiple)(void *pvDisplayData, int32_t i32X, int32_t i32Y, int32_t i32X0, int32_t i32Count, int32_t i32BPP, const uint8_t *pui8Data, const uint8_t *pui8Palette);
+    void (*pfnLineDrawH)(void *pvDisplayData, int32_t i32X1, int32_t i32X2, int32_t i32Y, uint32_t ui32Value);
+    void (*pfnLineDrawV)(void *pvDisplayData, int32_t i32X, int32_t i32Y1, int32_t i32Y2, uint32_t ui32Value);
+    void (*pfnRectFill)(void *pvDisplayData, const tRectangle *psRect, uint32_t ui32Value);
+    uint32_t (*pfnColorTranslate)(void *pvDisplayData, uint32_t ui32Value);
+    void (*pfnFlush)(void *pvDisplayData);
+} tDisplay;
+typedef struct { uint8_t ui8Format; uint8_t ui8MaxWidth; uint8_t ui8Height; uint8_t ui8Baseline; uint16_t pui16Offset[96]; const uint8_t *pui8Data; } tFont;
+typedef struct { int32_t i32Size; const tDisplay *psDisplay; tRectangle sClipRegion; uint32_t ui32Foreground; uint32_t ui32Background; const tFont *psFont; } tContext;
+extern const tFont g_sFontFixed6x8;
+#define ClrBlack 0x00000000
+#define ClrWhite 0x00FFFFFF
+#define ClrCyan 0x0000FFFF
+#define ClrYellow 0x00FFFF00
+#define ClrOlive 0x00808000
+#define ClrGray 0x00808080
+#define ClrRed 0x00FF0000
+#define ClrLime 0x0000FF00
+#define ClrGreen 0x00008000
+void GrContextInit(tContext *, const tDisplay *);
+void GrContextFontSet(tContext *, const tFont *);
+void GrContextForegroundSet(tContext *, uint32_t);
+void GrContextBackgroundSet(tContext *, uint32_t);
+void GrContextClipRegionSet(tContext *, tRectangle *);
+void GrRectFill(const tContext *, const tRectangle *);
+void GrRectDraw(const tContext *, const tRectangle *);
+void GrStringDraw(const tContext *, const char *, int32_t, int32_t, int32_t, uint32_t);
+int32_t GrStringWidthGet(const tContext *, const char *, int32_t);
+int32_t GrStringHeightGet(const tContext *);
+void GrStringDrawCentered(const tContext *, const char *, int32_t, int32_t, int32_t, uint32_t);
+void GrLineDrawH(const tContext *, int32_t, int32_t, int32_t);
+#define GrFlush(c) ((c)->psDisplay->pfnFlush((c)->psDisplay->pvDisplayData))
+uint32_t GrFontHeightGet(const tFont *);
+uint32_t GrFontBaselineGet(const tFont *);
+#define DpyPixelDrawMultiple(d, x, y, x0, n, b, p, pal) ((d)->pfnPixelDrawMultiple((d)->pvDisplayData, (x), (y), (x0), (n), (b), (p), (pal)))
+#define DpyColorTranslate(d, v) ((d)->pfnColorTranslate((d)->pvDisplayData, (v)))
+#ifdef __cplusplus
+}
+#endif
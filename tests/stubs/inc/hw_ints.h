@@ -0,0 +1,5 @@
+#pragma once
+#define INT_SSI2 73
+#define INT_GPIOJ 67
+#define INT_TIMER0A 35
+#define INT_TIMER1A 37
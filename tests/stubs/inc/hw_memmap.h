@@ -0,0 +1,31 @@
+#pragma once
+#define GPIO_PORTA_BASE 0x40058000
+#define GPIO_PORTD_BASE 0x4005B000
+#define GPIO_PORTH_BASE 0x4005F000
+#define GPIO_PORTJ_BASE 0x40060000
+#define GPIO_PORTL_BASE 0x40062000
+#define GPIO_PORTN_BASE 0x40064000
+#define SSI2_BASE 0x4000A000
+#define TIMER0_BASE 0x40030000
+#define TIMER1_BASE 0x40031000
+#define TIMER2_BASE 0x40032000
+#define TIMER3_BASE 0x40033000
+#define TIMER4_BASE 0x40034000
+#define TIMER5_BASE 0x40035000
+#define WTIMER0_BASE 0x40036000
+#define WTIMER1_BASE 0x40037000
+#define WTIMER2_BASE 0x4004C000
+#define WTIMER3_BASE 0x4004D000
+#define WTIMER4_BASE 0x4004E000
+#define WTIMER5_BASE 0x4004F000
+#define GPIO_PORTB_BASE 0x40059000
+#define GPIO_PORTC_BASE 0x4005A000
+#define GPIO_PORTE_BASE 0x4005C000
+#define GPIO_PORTF_BASE 0x4005D000
+#define GPIO_PORTG_BASE 0x4005E000
+#define GPIO_PORTK_BASE 0x40061000
+#define GPIO_PORTM_BASE 0x40063000
+#define GPIO_PORTP_BASE 0x40065000
+#define GPIO_PORTQ_BASE 0x40066000
+#define ADC0_BASE 0x40038000
+#define ADC1_BASE 0x40039000
@@ -0,0 +1,2 @@
+#pragma once
+#define NVIC_ST_CTRL 0xE000E010
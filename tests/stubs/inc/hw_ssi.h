@@ -0,0 +1,12 @@
+#pragma once
+#define SSI_O_CR0 0x0
+#define SSI_O_CR1 0x4
+#define SSI_O_DR 0x8
+#define SSI_O_SR 0xC
+#define SSI_CR0_DSS_M 0xF
+#define SSI_CR0_DSS_8 0x7
+#define SSI_CR0_DSS_16 0xF
+#define SSI_CR1_SSE 0x2
+#define SSI_CR1_EOT 0x10
+#define SSI_SR_TNF 0x2
+#define SSI_SR_BSY 0x10
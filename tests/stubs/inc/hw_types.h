@@ -0,0 +1,9 @@
+#pragma once
+#include <stdint.h>
+#ifdef SIM_HWREG
+// register accesses go to the test's hardware model
+extern volatile uint32_t *simReg(uint32_t ui32Address);
+#define HWREG(x) (*simReg((uint32_t)(x)))
+#else
+#define HWREG(x) (*((volatile uint32_t *)(x)))
+#endif
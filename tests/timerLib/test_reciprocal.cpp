@@ -0,0 +1,126 @@
+// Prueba en host de Reciprocal: divide(n) == n / d.
+//
+// Para divisores fijos (los de Timer a relojes habituales y los extremos de
+// 32 bits) y aleatorios, compara con la división de 64 bits en los bordes
+// (0, d - 1, d, múltiplos de d y sus vecinos, 2^32, 2^63, 2^64 - 1) y en
+// valores aleatorios de todos los tamaños. Luego comprueba que micros() y
+// millis() de Timer, que dividen con Reciprocal, dan ticks / ticksPorUs a
+// varios relojes, con un WTIMER simulado y con MANUAL.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include "check.h"
+#include "timerLib.h"
+
+static std::mt19937_64 rng(42);
+static uint64_t s_simTicks;                  // ticks del WTIMER simulado
+
+// ---- driverlib simulado -----------------------------------------------------
+
+extern "C" {
+void SysCtlPeripheralEnable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+void TimerClockSourceSet(uint32_t, uint32_t) {}
+void TimerConfigure(uint32_t, uint32_t) {}
+void TimerEnable(uint32_t, uint32_t) {}
+void TimerDisable(uint32_t, uint32_t) {}
+void TimerLoadSet(uint32_t, uint32_t, uint32_t) {}
+void TimerLoadSet64(uint32_t, uint64_t) {}
+uint32_t TimerValueGet(uint32_t, uint32_t) { return 0xFFFFFFFFu - (uint32_t)s_simTicks; }
+uint64_t TimerValueGet64(uint32_t) { return ~0ull - s_simTicks; }
+void TimerIntClear(uint32_t, uint32_t) {}
+void TimerIntEnable(uint32_t, uint32_t) {}
+uint32_t TimerIntStatus(uint32_t, bool) { return 0; }
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void)) {}
+bool IntMasterDisable(void) { return false; }
+bool IntMasterEnable(void) { return true; }
+}
+
+// ---- Reciprocal -------------------------------------------------------------
+
+static unsigned long s_mismatches;
+
+static void checkOne(const Reciprocal& r, uint32_t d, uint64_t n)
+{
+    if (r.divide(n) == n / d) return;
+    if (s_mismatches++ < 10) {
+        printf("d = %u, n = %llu: divide() = %llu, n / d = %llu\n", d,
+               (unsigned long long)n, (unsigned long long)r.divide(n),
+               (unsigned long long)(n / d));
+    }
+}
+
+static void checkDivisor(uint32_t d)
+{
+    Reciprocal r;
+    r.set(d);
+
+    const uint64_t edges[] = { 0, 1, (uint64_t)d - 1, d, (uint64_t)d + 1,
+                               (1ull << 32) - 1, 1ull << 32, (1ull << 63) - 1,
+                               1ull << 63, ~0ull - 1, ~0ull };
+    for (uint64_t n : edges) checkOne(r, d, n);
+
+    // múltiplos de d repartidos por todo el rango, y sus vecinos
+    uint64_t step = ~0ull / d / 2000;
+    for (uint64_t k = 1; k < 2000; k++) {
+        uint64_t m = k * step * d;
+        checkOne(r, d, m - 1);
+        checkOne(r, d, m);
+        checkOne(r, d, m + 1);
+    }
+
+    // aleatorios de 1 a 64 bits
+    for (int i = 0; i < 20000; i++) {
+        uint64_t n = rng() >> (rng() % 64);
+        checkOne(r, d, n);
+        checkOne(r, d, n / d * d);
+        checkOne(r, d, n / d * d - 1);
+    }
+}
+
+// ---- Timer ------------------------------------------------------------------
+
+static void checkTimer(uint32_t sysclkHz, uint32_t base)
+{
+    uint32_t ticksPerUs = (sysclkHz + 500000u) / 1000000u;
+    Timer t;
+
+    s_simTicks = rng();
+    CHECK(t.begin(sysclkHz, base));
+    uint64_t elapsed = 0;
+    unsigned long bad = 0;
+
+    for (int i = 0; i < 20000; i++) {
+        uint64_t n = rng() >> (rng() % 64 + 8);   // hasta 2^56 ticks por paso
+        if (base == Timer::MANUAL) t.advance(n);
+        else s_simTicks += n;
+        elapsed += n;
+        if (t.micros() != elapsed / ticksPerUs) bad++;
+        if (t.millis() != elapsed / ticksPerUs / 1000) bad++;
+    }
+    if (bad) printf("Timer %u Hz, base 0x%08x: %lu errores\n", sysclkHz, base, bad);
+    CHECK_EQ(bad, 0);
+}
+
+int main()
+{
+    const uint32_t divisors[] = { 1, 2, 3, 7, 10, 16, 25, 80, 120, 1000, 16000,
+                                  25000, 80000, 120000, 1000000, 0x7FFFFFFFu,
+                                  0x80000000u, 0x80000001u, 0xFFFFFFFFu };
+    for (uint32_t d : divisors) checkDivisor(d);
+    for (int i = 0; i < 200; i++) {
+        uint32_t d = (uint32_t)rng() >> (rng() % 32);
+        if (d) checkDivisor(d);
+    }
+    CHECK_EQ(s_mismatches, 0);
+
+    const uint32_t clocks[] = { 1000000, 16000000, 25000000, 33333333,
+                                80000000, 119999999, 120000000 };
+    for (uint32_t hz : clocks) {
+        checkTimer(hz, WTIMER0_BASE);
+        checkTimer(hz, Timer::MANUAL);
+    }
+
+    return CHECK_RESULT();
+}
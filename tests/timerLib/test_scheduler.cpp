@@ -0,0 +1,251 @@
+// Prueba en host del Scheduler sobre un reloj MANUAL.
+//
+// Un modelo lleva, por hueco, la tarea que debería haber (función, plazo,
+// periodo y ejecuciones). Las tareas avanzan el reloj lo que dura su trabajo
+// y, dentro de fn(), cancelan, se cancelan a sí mismas y crean tareas al
+// azar, también cancelarse y crear otra en el mismo hueco. Se comprueba en
+// cada pasada que el heap tiene cada tarea pendiente una sola vez:
+//   - run() ejecuta exactamente las vencidas al empezar que nadie canceló,
+//     cada una una vez y con su función,
+//   - add() solo devuelve huecos libres en el modelo y falla con 16 tareas,
+//   - nextDeadline() es el plazo mínimo del modelo,
+//   - stats().runs cuenta solo las ejecuciones de la tarea que ocupa el hueco.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <random>
+#include <utility>
+#include "check.h"
+#include "scheduler.h"
+
+static const uint32_t SYSCLK = 120000000;
+static const uint64_t TPM = SYSCLK / 1000;   // ticks por ms
+
+// ---- driverlib simulado (MANUAL no lo usa; solo enlaza timerLib.cpp) --------
+
+extern "C" {
+void SysCtlPeripheralEnable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+void TimerClockSourceSet(uint32_t, uint32_t) {}
+void TimerConfigure(uint32_t, uint32_t) {}
+void TimerEnable(uint32_t, uint32_t) {}
+void TimerDisable(uint32_t, uint32_t) {}
+void TimerLoadSet(uint32_t, uint32_t, uint32_t) {}
+void TimerLoadSet64(uint32_t, uint64_t) {}
+uint32_t TimerValueGet(uint32_t, uint32_t) { return 0; }
+uint64_t TimerValueGet64(uint32_t) { return 0; }
+void TimerIntClear(uint32_t, uint32_t) {}
+void TimerIntEnable(uint32_t, uint32_t) {}
+uint32_t TimerIntStatus(uint32_t, bool) { return 0; }
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void)) {}
+bool IntMasterDisable(void) { return false; }
+bool IntMasterEnable(void) { return true; }
+}
+
+// ---------------------------------------------------------------------------
+
+static const int NUM_FNS = 2 * Scheduler::MAX_TASKS;
+
+static Timer s_clock;
+static Scheduler* s_sched;
+static std::mt19937 s_rng(15);
+static unsigned long s_bad;
+
+// Tarea esperada en un hueco
+struct Slot {
+    bool     used;
+    int      fn;          // índice en s_fns
+    uint64_t deadline;
+    uint64_t period;      // 0 = una sola vez
+    uint32_t runs;
+    uint32_t serial;      // distinto en cada add()
+    bool     due;         // vencida al empezar la pasada y sin ejecutar aún
+};
+static Slot s_model[Scheduler::MAX_TASKS];
+static uint32_t s_ran, s_serial;
+
+static void fail(const char* what, int id)
+{
+    if (s_bad++ < 10) printf("%s (hueco %d, t = %llu)\n", what, id, (unsigned long long)s_clock.ticks());
+}
+
+static bool fnInUse(int fn)
+{
+    for (const Slot& m : s_model) {
+        if (m.used && m.fn == fn) return true;
+    }
+    return false;
+}
+
+static void taskBody(int fn);
+
+template <int K> static void taskFn() { taskBody(K); }
+
+static Scheduler::TaskFunction s_fns[NUM_FNS];
+
+template <int... K>
+static void fillFns(std::integer_sequence<int, K...>)
+{
+    Scheduler::TaskFunction fns[] = { taskFn<K>... };
+    for (int i = 0; i < NUM_FNS; i++) s_fns[i] = fns[i];
+}
+
+// Crea una tarea al azar y la anota en el modelo
+static Scheduler::TaskId addRandom()
+{
+    int fn;
+    do { fn = (int)(s_rng() % NUM_FNS); } while (fnInUse(fn));
+    bool periodic = s_rng() % 2;
+    uint32_t ms = s_rng() % 4 == 0 ? 0 : 1 + s_rng() % 40;
+    if (periodic && ms == 0) ms = 1;
+    uint8_t priority = (uint8_t)(s_rng() % 4);
+
+    int free = 0;
+    for (const Slot& m : s_model) free += !m.used;
+
+    uint64_t now = s_clock.ticks();
+    Scheduler::TaskId id = periodic ? s_sched->every(ms, s_fns[fn], priority)
+                                    : s_sched->after(ms, s_fns[fn], priority);
+    if (free == 0) {
+        if (id != -1) fail("add() con 16 tareas", id);
+        return -1;
+    }
+    if (id < 0 || s_model[id].used) {
+        fail("add() devolvió un hueco ocupado", id);
+        return -1;
+    }
+    Slot& m = s_model[id];
+    m.used = true;
+    m.fn = fn;
+    m.deadline = now + ms * TPM;
+    m.period = periodic ? ms * TPM : 0;
+    m.runs = 0;
+    m.serial = ++s_serial;
+    m.due = false;
+    return id;
+}
+
+static void cancelModel(Scheduler::TaskId id)
+{
+    bool expected = s_model[id].used;
+    if (s_sched->cancel(id) != expected) fail("cancel()", id);
+    s_model[id].used = false;
+    s_model[id].due = false;
+}
+
+static void taskBody(int fn)
+{
+    s_ran++;
+    int id = -1;
+    for (int i = 0; i < Scheduler::MAX_TASKS; i++) {
+        if (s_model[i].used && s_model[i].fn == fn) id = i;
+    }
+    if (id < 0 || !s_model[id].due) {
+        fail("ejecutó una tarea no vencida o cancelada", id);
+        return;
+    }
+    s_model[id].due = false;
+    uint32_t serial = s_model[id].serial;
+
+    // Trabajo de la tarea y acciones al azar
+    s_clock.advance(s_rng() % (3 * TPM));
+    switch (s_rng() % 8) {
+    case 0:                                   // se cancela y crea otra (mismo hueco)
+        cancelModel((Scheduler::TaskId)id);
+        addRandom();
+        break;
+    case 1:                                   // se cancela
+        cancelModel((Scheduler::TaskId)id);
+        break;
+    case 2:                                   // cancela otra
+        cancelModel((Scheduler::TaskId)(s_rng() % Scheduler::MAX_TASKS));
+        break;
+    case 3:                                   // crea otra
+        addRandom();
+        break;
+    default:
+        break;
+    }
+
+    // Lo que hace run() tras fn(), si el hueco sigue siendo esta tarea
+    Slot& m = s_model[id];
+    if (!m.used || m.serial != serial) return;
+    m.runs++;
+    if (m.period == 0) {
+        m.used = false;
+        return;
+    }
+    uint64_t end = s_clock.ticks();
+    m.deadline += m.period;
+    if (m.deadline <= end) m.deadline += ((end - m.deadline) / m.period + 1) * m.period;
+}
+
+static void checkModel()
+{
+    uint64_t next = UINT64_MAX;
+    for (int i = 0; i < Scheduler::MAX_TASKS; i++) {
+        const Slot& m = s_model[i];
+        if (!m.used) continue;
+        if (m.due) fail("vencida sin ejecutar", i);
+        if (m.deadline < next) next = m.deadline;
+        if (s_sched->stats((Scheduler::TaskId)i).runs != m.runs) fail("stats().runs", i);
+    }
+    if (s_sched->nextDeadline() != next) fail("nextDeadline()", -1);
+}
+
+int main()
+{
+    CHECK(s_clock.begin(SYSCLK, Timer::MANUAL));
+    fillFns(std::make_integer_sequence<int, NUM_FNS>());
+
+    // Una tarea periódica se cancela y crea una de una sola vez, que toma
+    // su hueco: la nueva se ejecuta una vez, en su plazo, sin las
+    // estadísticas de la anterior, y libera el hueco
+    {
+        static Scheduler sched(s_clock);
+        static Scheduler::TaskId self, oneShot;
+        static int oneShotRuns;
+        self = sched.every(10, [] {
+            sched.cancel(self);
+            oneShot = sched.after(5, [] { oneShotRuns++; });
+        });
+        s_clock.advance(10 * TPM);
+        CHECK_EQ(sched.run(), 1);
+        CHECK_EQ(oneShot, self);
+        CHECK_EQ(sched.stats(oneShot).runs, 0);
+        CHECK_EQ(sched.nextDeadline(), s_clock.ticks() + 5 * TPM);
+        s_clock.advance(5 * TPM);
+        CHECK_EQ(sched.run(), 1);
+        CHECK_EQ(oneShotRuns, 1);
+        CHECK_EQ(sched.nextDeadline(), UINT64_MAX);
+        s_clock.advance(100 * TPM);
+        CHECK_EQ(sched.run(), 0);
+    }
+
+    // Altas y bajas al azar, dentro y fuera de las tareas
+    Scheduler sched(s_clock);
+    s_sched = &sched;
+    unsigned long runs = 0;
+    for (int pass = 0; pass < 200000; pass++) {
+        if (s_rng() % 4 == 0) addRandom();
+        if (s_rng() % 16 == 0) cancelModel((Scheduler::TaskId)(s_rng() % Scheduler::MAX_TASKS));
+
+        s_clock.advance(s_rng() % 8 == 0 ? s_rng() % (60 * TPM) : s_rng() % (2 * TPM));
+        uint64_t now = s_clock.ticks();
+        uint32_t expected = 0;
+        for (Slot& m : s_model) {
+            m.due = m.used && m.deadline <= now;
+            expected += m.due;
+        }
+        s_ran = 0;
+        uint32_t ran = sched.run();
+        if (ran != s_ran) fail("run() devolvió otro número de tareas", -1);
+        if (ran > expected) fail("más ejecuciones que tareas vencidas", -1);
+        runs += ran;
+        checkModel();
+    }
+    CHECK_EQ(s_bad, 0);
+    CHECK(runs > 100000);
+
+    return CHECK_RESULT();
+}
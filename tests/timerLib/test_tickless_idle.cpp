@@ -0,0 +1,155 @@
+// Prueba en host de TicklessIdle con el Scheduler sobre un reloj MANUAL.
+//
+// El wake timer (TIMER1) se simula: TimerLoadSet/TimerEnable arman el
+// one-shot y SysCtlSleep() avanza el reloj hasta que vence (o hasta una
+// interrupción ajena programada antes) más una latencia fija de despertar.
+// Las tareas avanzan el reloj lo que dura su trabajo. Se comprueba que cada
+// tarea arranca exactamente en su plazo + latencia (o detrás de la otra si
+// vencen juntas), que la interrupción ajena cuenta como otherWakes y que
+// los plazos cercanos y lejanos se tratan como documenta sleepUntil().
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <vector>
+#include "check.h"
+#include "scheduler.h"
+#include "ticklessIdle.h"
+
+static const uint32_t SYSCLK = 120000000;
+static const uint32_t TICKS_PER_MS = SYSCLK / 1000;
+static const uint64_t LATENCY = 12;          // ticks de WFI a la primera instrucción
+
+static Timer clock;
+
+// ---- driverlib simulado -----------------------------------------------------
+
+static bool     s_wakeArmed;
+static uint32_t s_wakeLoad;
+static uint64_t s_wakeAt;                    // tick del reloj en que vence el one-shot
+static bool     s_wakeTimeout;               // TIMER_TIMA_TIMEOUT en el RIS
+static uint64_t s_otherIrqAt = ~0ull;        // tick de una interrupción ajena
+static bool     s_primask;
+static uint32_t s_lastSleepTicks;
+
+extern "C" {
+void SysCtlPeripheralEnable(uint32_t) {}
+bool SysCtlPeripheralReady(uint32_t) { return true; }
+void TimerClockSourceSet(uint32_t, uint32_t) {}
+void TimerConfigure(uint32_t, uint32_t) {}
+void TimerLoadSet64(uint32_t, uint64_t) {}
+uint32_t TimerValueGet(uint32_t, uint32_t) { return 0; }
+uint64_t TimerValueGet64(uint32_t) { return 0; }
+void TimerIntEnable(uint32_t, uint32_t) {}
+void TimerIntRegister(uint32_t, uint32_t, void (*)(void)) {}
+
+void TimerLoadSet(uint32_t base, uint32_t, uint32_t value)
+{
+    if (base == TIMER1_BASE) s_wakeLoad = value;
+}
+
+void TimerEnable(uint32_t base, uint32_t)
+{
+    if (base != TIMER1_BASE) return;
+    s_wakeArmed = true;
+    s_wakeAt = clock.ticks() + s_wakeLoad;
+}
+
+void TimerDisable(uint32_t base, uint32_t)
+{
+    if (base == TIMER1_BASE) s_wakeArmed = false;
+}
+
+void TimerIntClear(uint32_t, uint32_t) { s_wakeTimeout = false; }
+uint32_t TimerIntStatus(uint32_t, bool) { return s_wakeTimeout ? TIMER_TIMA_TIMEOUT : 0; }
+
+bool IntMasterDisable(void) { bool was = s_primask; s_primask = true; return was; }
+bool IntMasterEnable(void) { bool was = s_primask; s_primask = false; return was; }
+
+// WFI: duerme hasta el one-shot o hasta la interrupción ajena, lo primero
+void SysCtlSleep(void)
+{
+    uint64_t now = clock.ticks();
+    uint64_t wake = s_wakeArmed ? s_wakeAt : ~0ull;
+    if (s_otherIrqAt < wake) {
+        wake = s_otherIrqAt;
+        s_otherIrqAt = ~0ull;
+    } else {
+        s_wakeTimeout = true;
+    }
+    s_lastSleepTicks = s_wakeArmed ? s_wakeLoad : 0;
+    clock.advance(wake + LATENCY - now);
+}
+}
+
+// ---- tareas -----------------------------------------------------------------
+
+static std::vector<uint64_t> s_runsA, s_runsB;
+
+static void taskA() { s_runsA.push_back(clock.ticks()); clock.advance(3000); }  // 25 us de trabajo
+static void taskB() { s_runsB.push_back(clock.ticks()); clock.advance(1200); }  // 10 us
+
+int main()
+{
+    CHECK(clock.begin(SYSCLK, Timer::MANUAL));
+
+    // No acepta un reloj sin iniciar ni un WTIMER como wake timer
+    {
+        Timer none;
+        TicklessIdle noneIdle(none);
+        CHECK(!noneIdle.begin(TIMER1_BASE));
+    }
+    TicklessIdle idle(clock);
+    CHECK(!idle.begin(WTIMER1_BASE));
+    CHECK(idle.begin(TIMER1_BASE));
+
+    // Plazo ya vencido o demasiado cercano: vuelve sin dormir
+    uint64_t t = clock.ticks();
+    idle.sleepUntil(t);
+    idle.sleepUntil(t + TicklessIdle::MIN_SLEEP_TICKS);
+    CHECK_EQ(clock.ticks(), t);
+    CHECK_EQ(idle.stats().sleeps, 0);
+
+    // Plazo a más de 2^32 ticks: duerme 2^32 - 1 y vuelve antes del plazo
+    idle.sleepUntil(t + (1ull << 34));
+    CHECK_EQ(s_lastSleepTicks, 0xFFFFFFFFu);
+    CHECK_EQ(clock.ticks(), t + 0xFFFFFFFFull + LATENCY);
+    CHECK_EQ(idle.stats().timerWakes, 1);
+
+    // Scheduler: A cada 16 ms (prioridad 1), B cada 20 ms (prioridad 2)
+    Scheduler sched(clock);
+    idle.resetStats();
+    uint64_t t0 = clock.ticks();
+    sched.every(16, taskA, 1);
+    sched.every(20, taskB, 2);
+    s_otherIrqAt = t0 + 5000000;             // interrupción ajena a ~41.7 ms
+
+    while (clock.ticks() < t0 + 1000ull * TICKS_PER_MS) {
+        if (!sched.run()) idle.sleepUntil(sched.nextDeadline());
+    }
+
+    // 1 s: 62 de A y 50 de B (la de 1000 ms se corta en el límite del bucle)
+    CHECK_EQ(s_runsA.size(), 62);
+    CHECK(s_runsB.size() == 49 || s_runsB.size() == 50);
+
+    // Cada arranque en plazo + latencia; A detrás de B cuando vencen juntas
+    for (size_t i = 0; i < s_runsA.size(); i++) {
+        uint64_t deadline = t0 + (i + 1) * 16 * TICKS_PER_MS;
+        uint64_t late = s_runsA[i] - deadline;
+        bool withB = (i + 1) * 16 % 20 == 0;
+        CHECK_EQ(late, withB ? LATENCY + 1200 : LATENCY);
+    }
+    for (size_t i = 0; i < s_runsB.size(); i++) {
+        uint64_t deadline = t0 + (i + 1) * 20 * TICKS_PER_MS;
+        CHECK_EQ(s_runsB[i] - deadline, LATENCY);
+    }
+
+    const TicklessIdle::Stats& s = idle.stats();
+    CHECK_EQ(s.otherWakes, 1);
+    CHECK_EQ(s.timerWakes + s.otherWakes, s.sleeps);
+    CHECK_EQ(s.lastLatency, LATENCY);
+    CHECK_EQ(s.maxLatency, LATENCY);
+    // Despierto: 62 * 3000 + 50 * 1200 ticks de trabajo + latencias, de 1 s
+    CHECK(idle.dutyCyclePermille() <= 3);
+
+    return CHECK_RESULT();
+}